@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t tasks_per_producer{200000};  ///< Trivial tasks posted by each producer per run
+constexpr std::size_t runs{5};                     ///< Runs per pool, the fastest one is reported
+
+/**
+ * @brief Measures how many trivial tasks per second concurrent producers get through a pool
+ *
+ * All producers start at once and post without pausing, so they contend on the queue. The run
+ * ends when the pool is idle again.
+ *
+ * @returns Tasks per second of the fastest run
+ */
+template<typename Pool>
+double measureThroughput(std::size_t number_of_threads, std::size_t number_of_producers) {
+    double best{0.0};
+    for (std::size_t run{0}; run < runs; ++run) {
+        Pool pool{number_of_threads};
+        std::vector<std::thread> producers{};
+        const auto start{std::chrono::steady_clock::now()};
+        for (std::size_t producer{0}; producer < number_of_producers; ++producer) {
+            producers.emplace_back([&pool]() {
+                for (std::size_t task{0}; task < tasks_per_producer; ++task) {
+                    pool.post([]() {});
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        pool.waitIdle();
+
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        best = std::max(best, static_cast<double>(number_of_producers * tasks_per_producer) / elapsed.count());
+    }
+    return best;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t number_of_threads{std::max(std::thread::hardware_concurrency(), 2U)};
+    const std::size_t number_of_producers{number_of_threads};
+    std::printf("%zu workers, %zu producers, %zu tasks per producer\n", number_of_threads, number_of_producers,
+                tasks_per_producer);
+
+    const auto locked{measureThroughput<pool_party::ThreadPool>(number_of_threads, number_of_producers)};
+    const auto ring_buffer{measureThroughput<pool_party::RingBufferThreadPool>(number_of_threads, number_of_producers)};
+    const auto work_stealing{
+        measureThroughput<pool_party::WorkStealingThreadPool>(number_of_threads, number_of_producers)};
+
+    std::printf("ThreadPool:             %12.0f tasks/s\n", locked);
+    std::printf("RingBufferThreadPool:   %12.0f tasks/s (%.2fx)\n", ring_buffer, ring_buffer / locked);
+    std::printf("WorkStealingThreadPool: %12.0f tasks/s (%.2fx)\n", work_stealing, work_stealing / locked);
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_ALGORITHMS_HPP_
+#define POOL_PARTY_ALGORITHMS_HPP_
+
+#include "detail/parallel_loop.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+
+/**
+ * @brief Calls a function for each index of a range in parallel
+ *
+ * The range is split into chunks which are processed by the workers of the pool and the calling
+ * thread. The function returns when all indices are processed, so it can be used within tasks of
+ * the same pool.
+ *
+ * @tparam Pool Thread pool type
+ * @tparam Index Integral index type
+ * @tparam Function Type of the callable which is called with an index
+ *
+ * @param pool Thread pool which helps processing the range
+ * @param first First index
+ * @param last Index behind the last index
+ * @param function Callable which is called with each index
+ * @param chunking Strategy which determines the chunk sizes
+ * @param grain_size Minimum number of indices per chunk
+ *
+ * @exception Rethrows the first exception of the function, remaining chunks are skipped then
+ * @exception std::runtime_error is thrown when the thread pool is already shut down
+ */
+template<typename Pool, typename Index, typename Function>
+void parallelFor(Pool& pool,
+                 Index first,
+                 Index last,
+                 Function&& function,
+                 Chunking chunking      = Chunking::guided,
+                 std::size_t grain_size = 1) {
+    static_assert(std::is_integral<Index>::value, "parallelFor requires an integral index type");
+    if (last <= first) {
+        return;
+    }
+
+    detail::runParallelLoop(pool,
+                            static_cast<std::size_t>(last - first),
+                            chunking,
+                            grain_size,
+                            [first, &function](std::size_t begin, std::size_t end) {
+                                for (auto index{begin}; index < end; ++index) {
+                                    function(static_cast<Index>(first + static_cast<Index>(index)));
+                                }
+                            });
+}
+
+/**
+ * @brief Transforms each element of a range and reduces the results in parallel
+ *
+ * Each chunk is reduced separately, the partial results are combined in the order of the range.
+ * Therefore the reduction has to be associative, but not commutative.
+ *
+ * @tparam Pool Thread pool type
+ * @tparam RandomIt Random access iterator type
+ * @tparam T Type of the result
+ * @tparam Reduce Type of the binary reduction
+ * @tparam Transform Type of the unary transformation
+ *
+ * @param pool Thread pool which helps processing the range
+ * @param first Iterator to the first element
+ * @param last Iterator behind the last element
+ * @param init Initial value of the reduction
+ * @param reduce Associative binary callable which combines two values of type T
+ * @param transform Unary callable which is applied to each element
+ * @param chunking Strategy which determines the chunk sizes
+ * @param grain_size Minimum number of elements per chunk
+ *
+ * @returns The reduction of init and all transformed elements
+ *
+ * @exception Rethrows the first exception of reduce or transform
+ * @exception std::runtime_error is thrown when the thread pool is already shut down
+ */
+template<typename Pool, typename RandomIt, typename T, typename Reduce, typename Transform>
+T parallelTransformReduce(Pool& pool,
+                          RandomIt first,
+                          RandomIt last,
+                          T init,
+                          Reduce reduce,
+                          Transform transform,
+                          Chunking chunking      = Chunking::guided,
+                          std::size_t grain_size = 1) {
+    std::mutex partials_mtx{};
+    std::vector<std::pair<std::size_t, T>> partials{};  // Partial results keyed by the first index of their chunk
+
+    detail::runParallelLoop(pool,
+                            static_cast<std::size_t>(std::distance(first, last)),
+                            chunking,
+                            grain_size,
+                            [&](std::size_t begin, std::size_t end) {
+                                auto it{first + static_cast<std::ptrdiff_t>(begin)};
+                                T partial(transform(*it));
+                                for (++it; it != first + static_cast<std::ptrdiff_t>(end); ++it) {
+                                    partial = reduce(std::move(partial), transform(*it));
+                                }
+                                std::lock_guard<std::mutex> lg{partials_mtx};
+                                partials.emplace_back(begin, std::move(partial));
+                            });
+
+    using PartialType = std::pair<std::size_t, T>;
+    std::sort(partials.begin(), partials.end(), [](const PartialType& lhs, const PartialType& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (auto& partial : partials) {
+        init = reduce(std::move(init), std::move(partial.second));
+    }
+    return init;
+}
+
+/**
+ * @brief Reduces the elements of a range in parallel
+ *
+ * @see pool_party::parallelTransformReduce
+ *
+ * @returns The reduction of init and all elements
+ */
+template<typename Pool, typename RandomIt, typename T, typename Reduce>
+T parallelReduce(Pool& pool,
+                 RandomIt first,
+                 RandomIt last,
+                 T init,
+                 Reduce reduce,
+                 Chunking chunking      = Chunking::guided,
+                 std::size_t grain_size = 1) {
+    using ReferenceType = typename std::iterator_traits<RandomIt>::reference;
+    return parallelTransformReduce(pool,
+                                   first,
+                                   last,
+                                   std::move(init),
+                                   std::move(reduce),
+                                   [](ReferenceType value) -> ReferenceType { return value; },
+                                   chunking,
+                                   grain_size);
+}
+
+/**
+ * @brief Computes the inclusive prefix scan of a range in parallel
+ *
+ * The range is split into one block per participating thread. The first pass reduces each block,
+ * the second pass scans each block starting with the reduction of all preceding blocks. The
+ * operation has to be associative and the value type default constructible. The output range may
+ * be the input range.
+ *
+ * @tparam Pool Thread pool type
+ * @tparam RandomIt Random access iterator type of the input range
+ * @tparam OutputRandomIt Random access iterator type of the output range
+ * @tparam BinaryOperation Type of the binary operation
+ *
+ * @param pool Thread pool which helps processing the range
+ * @param first Iterator to the first element
+ * @param last Iterator behind the last element
+ * @param d_first Iterator to the first element of the output range
+ * @param operation Associative binary callable
+ *
+ * @returns Iterator behind the last written element
+ *
+ * @exception Rethrows the first exception of the operation
+ * @exception std::runtime_error is thrown when the thread pool is already shut down
+ */
+template<typename Pool, typename RandomIt, typename OutputRandomIt, typename BinaryOperation>
+OutputRandomIt
+parallelInclusiveScan(Pool& pool, RandomIt first, RandomIt last, OutputRandomIt d_first, BinaryOperation operation) {
+    using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+
+    const auto size{static_cast<std::size_t>(std::distance(first, last))};
+    if (size == 0) {
+        return d_first;
+    }
+
+    const auto participants{std::min(pool.getNumberOfThreads() + 1, size)};
+    const auto block_size{(size + participants - 1) / participants};
+    const auto number_of_blocks{(size + block_size - 1) / block_size};
+    const auto blockBegin = [block_size](std::size_t block) { return static_cast<std::ptrdiff_t>(block * block_size); };
+    const auto blockEnd   = [block_size, size](std::size_t block) {
+        return static_cast<std::ptrdiff_t>(std::min((block + 1) * block_size, size));
+    };
+
+    // The last block's reduction isn't needed by any other block
+    std::vector<ValueType> block_sums(number_of_blocks - 1);
+    detail::runParallelLoop(
+    pool, number_of_blocks - 1, Chunking::static_size, 1, [&](std::size_t begin, std::size_t end) {
+        for (auto block{begin}; block < end; ++block) {
+            auto it{first + blockBegin(block)};
+            ValueType sum(*it);
+            for (++it; it != first + blockEnd(block); ++it) {
+                sum = operation(std::move(sum), *it);
+            }
+            block_sums[block] = std::move(sum);
+        }
+    });
+    for (std::size_t block{1}; block < block_sums.size(); ++block) {
+        block_sums[block] = operation(block_sums[block - 1], block_sums[block]);
+    }
+
+    detail::runParallelLoop(pool, number_of_blocks, Chunking::static_size, 1, [&](std::size_t begin, std::size_t end) {
+        for (auto block{begin}; block < end; ++block) {
+            auto it{first + blockBegin(block)};
+            auto d_it{d_first + blockBegin(block)};
+            ValueType sum(block == 0 ? ValueType(*it) : operation(block_sums[block - 1], *it));
+            *d_it = sum;
+            for (++it, ++d_it; it != first + blockEnd(block); ++it, ++d_it) {
+                sum   = operation(std::move(sum), *it);
+                *d_it = sum;
+            }
+        }
+    });
+
+    return d_first + static_cast<std::ptrdiff_t>(size);
+}
+
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_ALGORITHMS_HPP_
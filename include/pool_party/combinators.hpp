@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_COMBINATORS_HPP_
+#define POOL_PARTY_COMBINATORS_HPP_
+
+#include "detail/future.hpp"
+#include "detail/task.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+
+/**
+ * @brief Result of whenAny, the index of the first finished future and its value
+ *
+ * @tparam R Result type of the futures
+ */
+template<typename R>
+struct WhenAnyResult {
+    std::size_t index;  ///< Index of the first finished future
+    R value;            ///< Result of the first finished future
+};
+
+/**
+ * @brief Result of whenAny for futures without value
+ */
+template<>
+struct WhenAnyResult<void> {
+    std::size_t index;  ///< Index of the first finished future
+};
+
+namespace detail {
+
+/**
+ * @brief Result type of whenAll, all results in the order of the futures
+ */
+template<typename R>
+struct WhenAllResult {
+    using type = std::vector<R>;
+};
+
+template<>
+struct WhenAllResult<void> {
+    using type = void;
+};
+
+/**
+ * @brief Shared state of whenAll, counts down the unfinished futures
+ *
+ * @tparam R Result type of the futures
+ */
+template<typename R>
+class WhenAllState {
+public:
+    using InputStateType  = typename Future<R>::StateType;
+    using ResultStateType = typename Future<typename WhenAllResult<R>::type>::StateType;
+
+    WhenAllState(std::vector<std::shared_ptr<InputStateType>>&& inputs, std::shared_ptr<ResultStateType> result) :
+            m_inputs{std::move(inputs)}, m_pending_inputs{m_inputs.size()}, m_result{std::move(result)} {}
+
+    /**
+     * @brief Registers at the inputs, the last finishing input publishes the combined result
+     */
+    static void start(const std::shared_ptr<WhenAllState>& state) {
+        for (const auto& input : state->m_inputs) {
+            input->onReady(Task{[state]() { state->finishInput(); }}, true);
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<InputStateType>> m_inputs;  ///< States of the combined futures
+    std::atomic<std::size_t> m_pending_inputs;              ///< Number of unfinished futures
+    std::shared_ptr<ResultStateType> m_result;              ///< State which receives the combined result
+
+    void finishInput() {
+        if (--m_pending_inputs != 0) {
+            return;
+        }
+
+        for (const auto& input : m_inputs) {
+            if (input->getException()) {
+                m_result->setException(input->getException());
+                return;
+            }
+        }
+        publish(std::is_void<R>{});
+    }
+
+    void publish(std::false_type /*is_void*/) {
+        std::vector<R> values{};
+        values.reserve(m_inputs.size());
+        for (const auto& input : m_inputs) {
+            values.push_back(std::move(input->get()));
+        }
+        m_result->setValue(std::move(values));
+    }
+
+    void publish(std::true_type /*is_void*/) {
+        m_result->setValue();
+    }
+};
+
+/**
+ * @brief Shared state of whenAny, the first finishing future publishes the result
+ *
+ * @tparam R Result type of the futures
+ */
+template<typename R>
+class WhenAnyState {
+public:
+    using InputStateType  = typename Future<R>::StateType;
+    using ResultStateType = typename Future<WhenAnyResult<R>>::StateType;
+
+    explicit WhenAnyState(std::shared_ptr<ResultStateType> result) : m_result{std::move(result)} {}
+
+    /**
+     * @brief Registers at the inputs, the first finishing input publishes its result
+     */
+    static void start(const std::shared_ptr<WhenAnyState>& state,
+                      const std::vector<std::shared_ptr<InputStateType>>& inputs) {
+        for (std::size_t index{0}; index < inputs.size(); ++index) {
+            // The input owns its continuation, so it is alive whenever the continuation runs
+            auto* const input{inputs[index].get()};
+            input->onReady(Task{[state, input, index]() { state->finishInput(*input, index); }}, true);
+        }
+    }
+
+private:
+    std::atomic<bool> m_is_finished{false};     ///< Set by the first finishing future
+    std::shared_ptr<ResultStateType> m_result;  ///< State which receives the result
+
+    void finishInput(InputStateType& input, std::size_t index) {
+        if (m_is_finished.exchange(true)) {
+            return;
+        }
+
+        if (input.getException()) {
+            m_result->setException(input.getException());
+            return;
+        }
+        publish(input, index, std::is_void<R>{});
+    }
+
+    void publish(InputStateType& input, std::size_t index, std::false_type /*is_void*/) {
+        m_result->setValue(WhenAnyResult<R>{index, std::move(input.get())});
+    }
+
+    void publish(InputStateType&, std::size_t index, std::true_type /*is_void*/) {
+        m_result->setValue(WhenAnyResult<void>{index});
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Combines futures into a future of all of their results
+ *
+ * The futures are not polled, each finishing future counts down an atomic counter and the last
+ * one publishes the combined result. Continuations of the combined future are scheduled on the
+ * pool of the first future. If futures failed, the exception of the first failed future in the
+ * order of the vector is passed on.
+ *
+ * @tparam R Result type of the futures
+ *
+ * @param futures Valid futures which are consumed
+ *
+ * @returns Future with the results in the order of the futures, Future<void> for futures without value
+ */
+template<typename R>
+detail::Future<typename detail::WhenAllResult<R>::type> whenAll(std::vector<detail::Future<R>> futures) {
+    using StateType  = detail::WhenAllState<R>;
+    using ResultType = typename detail::WhenAllResult<R>::type;
+
+    std::vector<std::shared_ptr<typename StateType::InputStateType>> inputs{};
+    inputs.reserve(futures.size());
+    for (auto& future : futures) {
+        inputs.push_back(detail::FutureAccess::releaseState(future));
+    }
+
+    const auto scheduler{inputs.empty() ? nullptr : inputs.front()->getScheduler()};
+    const auto executor{inputs.empty() ? nullptr : inputs.front()->getExecutor()};
+    auto result{std::make_shared<typename StateType::ResultStateType>(scheduler, executor)};
+    if (inputs.empty()) {
+        result->setValue();
+        return detail::Future<ResultType>{std::move(result)};
+    }
+
+    StateType::start(std::make_shared<StateType>(std::move(inputs), result));
+    return detail::Future<ResultType>{std::move(result)};
+}
+
+/**
+ * @brief Combines futures into a future of the first finishing one
+ *
+ * The first finishing future publishes its index and result, or its exception. The results of
+ * the other futures are dropped. Continuations of the combined future are scheduled on the pool
+ * of the first future.
+ *
+ * @tparam R Result type of the futures
+ *
+ * @param futures Valid futures which are consumed
+ *
+ * @returns Future with the index and the result of the first finishing future
+ *
+ * @exception std::invalid_argument is thrown when no future is passed
+ */
+template<typename R>
+detail::Future<WhenAnyResult<R>> whenAny(std::vector<detail::Future<R>> futures) {
+    using StateType = detail::WhenAnyState<R>;
+
+    if (futures.empty()) {
+        throw std::invalid_argument{"whenAny requires at least one future."};
+    }
+
+    std::vector<std::shared_ptr<typename StateType::InputStateType>> inputs{};
+    inputs.reserve(futures.size());
+    for (auto& future : futures) {
+        inputs.push_back(detail::FutureAccess::releaseState(future));
+    }
+
+    auto result{std::make_shared<typename StateType::ResultStateType>(inputs.front()->getScheduler(),
+                                                                      inputs.front()->getExecutor())};
+    StateType::start(std::make_shared<StateType>(result), inputs);
+    return detail::Future<WhenAnyResult<R>>{std::move(result)};
+}
+
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_COMBINATORS_HPP_
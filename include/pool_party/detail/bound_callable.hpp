@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_BOUND_CALLABLE_HPP_
+#define POOL_PARTY_DETAIL_BOUND_CALLABLE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Compile time sequence of tuple indices, std::index_sequence is only available since C++14
+ */
+template<std::size_t... Indices>
+struct IndexSequence {};
+
+template<std::size_t Size, std::size_t... Indices>
+struct MakeIndexSequence : MakeIndexSequence<Size - 1, Size - 1, Indices...> {};
+
+template<std::size_t... Indices>
+struct MakeIndexSequence<0, Indices...> {
+    using type = IndexSequence<Indices...>;
+};
+
+/**
+ * @brief Type in which a callable is stored, pointers to members are wrapped by std::mem_fn
+ */
+template<typename Decayed, bool = std::is_member_pointer<Decayed>::value>
+struct StoredCallableType {
+    using type = Decayed;
+};
+
+template<typename Decayed>
+struct StoredCallableType<Decayed, true> {
+    using type = decltype(std::mem_fn(std::declval<Decayed>()));
+};
+
+template<typename Callable>
+using StoredCallable = typename StoredCallableType<typename std::decay<Callable>::type>::type;
+
+template<typename Callable>
+StoredCallable<Callable> storeCallable(Callable&& callable, std::false_type /*is_member_pointer*/) {
+    return std::forward<Callable>(callable);
+}
+
+template<typename Callable>
+StoredCallable<Callable> storeCallable(Callable&& callable, std::true_type /*is_member_pointer*/) {
+    return std::mem_fn(callable);
+}
+
+/**
+ * @brief Converts a callable into the type in which it is stored
+ *
+ * @returns The decayed callable, pointers to members wrapped by std::mem_fn
+ */
+template<typename Callable>
+StoredCallable<Callable> storeCallable(Callable&& callable) {
+    return storeCallable(std::forward<Callable>(callable),
+                         std::is_member_pointer<typename std::decay<Callable>::type>{});
+}
+
+/**
+ * @brief Callable which calls the wrapped callable with stored arguments
+ *
+ * Replaces std::bind for the tasks of the thread pool. It neither interprets placeholders nor
+ * nested bind expressions and, like std::bind, passes the stored arguments as lvalues.
+ *
+ * @tparam Callable Type of the wrapped callable
+ * @tparam Args Types of the stored arguments
+ */
+template<typename Callable, typename... Args>
+class BoundCallable {
+public:
+    template<typename... BoundArgs>
+    explicit BoundCallable(Callable&& callable, BoundArgs&&... args) :
+            m_callable{std::move(callable)}, m_args{std::forward<BoundArgs>(args)...} {}
+
+    auto operator()() -> decltype(std::declval<Callable&>()(std::declval<Args&>()...)) {
+        return call(typename MakeIndexSequence<sizeof...(Args)>::type{});
+    }
+
+private:
+    Callable m_callable;         ///< Wrapped callable
+    std::tuple<Args...> m_args;  ///< Arguments which are passed to the callable
+
+    template<std::size_t... Indices>
+    auto call(IndexSequence<Indices...>) -> decltype(std::declval<Callable&>()(std::declval<Args&>()...)) {
+        return m_callable(std::get<Indices>(m_args)...);
+    }
+};
+
+/**
+ * @brief Prepares a callable without arguments for a task
+ *
+ * @returns The decayed callable
+ */
+template<typename Callable>
+StoredCallable<Callable> bindArguments(Callable&& callable) {
+    return storeCallable(std::forward<Callable>(callable));
+}
+
+/**
+ * @brief Binds arguments to a callable for a task
+ *
+ * @param callable The callable which is copied or moved into the result
+ * @param arg First argument which is copied or moved into the result
+ * @param args Further arguments which are copied or moved into the result
+ *
+ * @returns Callable without arguments which calls the callable with the arguments
+ */
+template<typename Callable, typename Arg, typename... Args>
+BoundCallable<StoredCallable<Callable>, typename std::decay<Arg>::type, typename std::decay<Args>::type...>
+bindArguments(Callable&& callable, Arg&& arg, Args&&... args) {
+    return BoundCallable<StoredCallable<Callable>, typename std::decay<Arg>::type, typename std::decay<Args>::type...>{
+    storeCallable(std::forward<Callable>(callable)), std::forward<Arg>(arg), std::forward<Args>(args)...};
+}
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_BOUND_CALLABLE_HPP_
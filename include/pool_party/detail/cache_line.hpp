@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_CACHE_LINE_HPP_
+#define POOL_PARTY_DETAIL_CACHE_LINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace pool_party {
+namespace detail {
+
+constexpr std::size_t cache_line_size{64};  ///< Assumed size of a cache line to avoid false sharing
+
+/**
+ * @brief Allocator which places the storage of containers at the start of a cache line
+ *
+ * Before C++17 std::allocator ignores alignments above alignof(std::max_align_t), so the elements
+ * of a std::vector of a type with alignas(cache_line_size) may still share cache lines. This
+ * allocator aligns the storage by hand and keeps the address of the underlying allocation in
+ * front of it.
+ *
+ * @tparam T Type of the allocated elements
+ */
+template<typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    CacheAlignedAllocator() = default;
+
+    template<typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+    /**
+     * @brief Allocates uninitialized storage for elements, aligned to a cache line
+     *
+     * @param number_of_elements Number of elements which fit into the storage
+     *
+     * @exception std::bad_alloc is thrown when the storage can't be allocated
+     *
+     * @returns Pointer to the storage
+     */
+    T* allocate(std::size_t number_of_elements) {
+        constexpr std::size_t overhead{cache_line_size + sizeof(void*)};
+        if (number_of_elements > (std::numeric_limits<std::size_t>::max() - overhead) / sizeof(T)) {
+            throw std::bad_alloc{};
+        }
+
+        void* const allocation{::operator new(number_of_elements * sizeof(T) + overhead)};
+        const auto address{(reinterpret_cast<std::uintptr_t>(allocation) + overhead) & ~(cache_line_size - 1)};
+        reinterpret_cast<void**>(address)[-1] = allocation;
+        return reinterpret_cast<T*>(address);
+    }
+
+    /**
+     * @brief Releases storage of allocate
+     *
+     * @param storage Pointer which was returned by allocate
+     */
+    void deallocate(T* storage, std::size_t) {
+        ::operator delete(reinterpret_cast<void**>(storage)[-1]);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) {
+    return false;
+}
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_CACHE_LINE_HPP_
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_CANCELLATION_HPP_
+#define POOL_PARTY_DETAIL_CANCELLATION_HPP_
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Exception which reports that a task was cancelled
+ *
+ * Futures of cancelled tasks receive this exception. Running tasks can throw it with
+ * CancellationToken::throwIfCancelled to stop early, posted tasks which stop this way are not
+ * reported to the exception handler.
+ */
+class TaskCancelled : public std::runtime_error {
+public:
+    TaskCancelled() : std::runtime_error{"Task was cancelled."} {}
+};
+
+/**
+ * @brief Read-only view on the cancellation state of a CancellationSource
+ *
+ * Tokens are cheap to copy and can be checked from any thread. A default constructed token is
+ * never cancelled.
+ */
+class CancellationToken {
+public:
+    /**
+     * @brief Constructor of a token which is never cancelled
+     */
+    CancellationToken() = default;
+
+    /**
+     * @brief Checks if the source of the token requested a cancellation
+     */
+    bool isCancelled() const {
+        return m_is_cancelled && m_is_cancelled->load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Throws if the source of the token requested a cancellation
+     *
+     * @exception pool_party::detail::TaskCancelled is thrown when the token is cancelled
+     */
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw TaskCancelled{};
+        }
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> is_cancelled) :
+            m_is_cancelled{std::move(is_cancelled)} {}
+
+    std::shared_ptr<const std::atomic<bool>> m_is_cancelled{};  ///< State shared with the source, nullptr if never set
+};
+
+/**
+ * @brief Requests the cancellation of all tasks which got one of its tokens
+ */
+class CancellationSource {
+public:
+    /**
+     * @brief Constructor of a source which is not cancelled yet
+     */
+    CancellationSource() : m_is_cancelled{std::make_shared<std::atomic<bool>>(false)} {}
+
+    /**
+     * @brief Creates a token which observes this source
+     */
+    CancellationToken getToken() const {
+        return CancellationToken{m_is_cancelled};
+    }
+
+    /**
+     * @brief Requests the cancellation, which can't be revoked
+     */
+    void cancel() {
+        m_is_cancelled->store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks if the cancellation was requested
+     */
+    bool isCancelled() const {
+        return m_is_cancelled->load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_is_cancelled;  ///< State shared with the tokens
+};
+
+/**
+ * @brief Callable which skips the wrapped callable once its token is cancelled
+ *
+ * @tparam Callable Type of the wrapped callable
+ */
+template<typename Callable>
+class CancellableCallable {
+public:
+    CancellableCallable(CancellationToken token, Callable&& callable) :
+            m_token{std::move(token)}, m_callable{std::move(callable)} {}
+
+    /**
+     * @brief Calls the wrapped callable unless the token is cancelled
+     *
+     * @exception pool_party::detail::TaskCancelled is thrown instead of calling a cancelled callable
+     */
+    typename std::result_of<Callable()>::type operator()() {
+        m_token.throwIfCancelled();
+        return m_callable();
+    }
+
+private:
+    CancellationToken m_token;  ///< Token which is checked before the call
+    Callable m_callable;        ///< Wrapped callable
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_CANCELLATION_HPP_
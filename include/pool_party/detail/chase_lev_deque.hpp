@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_CHASE_LEV_DEQUE_HPP_
+#define POOL_PARTY_DETAIL_CHASE_LEV_DEQUE_HPP_
+
+#include "cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Lock-free work stealing deque
+ *
+ * Implementation of the dynamic circular work stealing deque by Chase and Lev with the memory
+ * orderings of Le et al. ("Correct and Efficient Work-Stealing for Weak Memory Models").
+ *
+ * The owning thread pushes and pops items at the bottom (lifo), all other threads steal items
+ * from the top (fifo). The buffer grows when the owner runs out of space. Retired buffers are kept
+ * until the deque is destroyed, because thieves may still read from them.
+ *
+ * @tparam T Type of the stored items, must be trivially copyable since thieves read items before
+ *           they know if they won the race for them
+ */
+template<typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque requires trivially copyable items");
+
+public:
+    /**
+     * @brief Constructor of ChaseLevDeque
+     *
+     * @param initial_capacity Initial number of slots, rounded up to the next power of two
+     */
+    explicit ChaseLevDeque(std::size_t initial_capacity = 64) {
+        std::int64_t capacity{1};
+        while (capacity < static_cast<std::int64_t>(initial_capacity)) {
+            capacity *= 2;
+        }
+        m_buffers.emplace_back(new Buffer{capacity});
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+    ChaseLevDeque(const ChaseLevDeque&)            = delete;
+    ChaseLevDeque(ChaseLevDeque&&)                 = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(ChaseLevDeque&&)      = delete;
+    ~ChaseLevDeque()                               = default;
+
+    /**
+     * @brief Pushes an item to the bottom of the deque
+     *
+     * @pre Must only be called by the owning thread
+     *
+     * @param item Item to push
+     */
+    void push(T item) {
+        const auto bottom{m_bottom.load(std::memory_order_relaxed)};
+        const auto top{m_top.load(std::memory_order_acquire)};
+        auto* buffer{m_buffer.load(std::memory_order_relaxed)};
+
+        if (bottom - top > buffer->capacity() - 1) {
+            buffer = grow(buffer, top, bottom);
+        }
+
+        buffer->store(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pops the newest item from the bottom of the deque
+     *
+     * @pre Must only be called by the owning thread
+     *
+     * @param item Receives the popped item
+     *
+     * @returns True if an item was popped, false if the deque is empty
+     */
+    bool pop(T& item) {
+        const auto bottom{m_bottom.load(std::memory_order_relaxed) - 1};
+        auto* buffer{m_buffer.load(std::memory_order_relaxed)};
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top{m_top.load(std::memory_order_relaxed)};
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = buffer->load(bottom);
+        if (top < bottom) {
+            return true;
+        }
+
+        // Last item, race against the thieves for it
+        const bool won{
+        m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)};
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    /**
+     * @brief Steals the oldest item from the top of the deque
+     *
+     * This function can be called from any thread. It fails when the deque is empty or another
+     * thread took the oldest item concurrently.
+     *
+     * @param item Receives the stolen item
+     *
+     * @returns True if an item was stolen, false otherwise
+     */
+    bool steal(T& item) {
+        auto top{m_top.load(std::memory_order_acquire)};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom{m_bottom.load(std::memory_order_acquire)};
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        item = m_buffer.load(std::memory_order_acquire)->load(top);
+        return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Approximated number of items in the deque
+     *
+     * @returns Number of items, may be outdated when other threads modify the deque
+     */
+    std::size_t size() const {
+        const auto bottom{m_bottom.load(std::memory_order_seq_cst)};
+        const auto top{m_top.load(std::memory_order_seq_cst)};
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    /**
+     * @brief Checks if the deque is empty
+     *
+     * @returns True if no item is stored, may be outdated when other threads modify the deque
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    /**
+     * @brief Circular buffer of atomic slots
+     */
+    class Buffer {
+    public:
+        explicit Buffer(std::int64_t capacity) :
+                m_capacity{capacity}, m_slots{new std::atomic<T>[static_cast<std::size_t>(capacity)]} {}
+
+        std::int64_t capacity() const {
+            return m_capacity;
+        }
+
+        T load(std::int64_t index) const {
+            return m_slots[slot(index)].load(std::memory_order_relaxed);
+        }
+
+        void store(std::int64_t index, T item) {
+            m_slots[slot(index)].store(item, std::memory_order_relaxed);
+        }
+
+    private:
+        std::int64_t m_capacity;                     ///< Number of slots, always a power of two
+        std::unique_ptr<std::atomic<T>[]> m_slots;  ///< Slots of the buffer
+
+        std::size_t slot(std::int64_t index) const {
+            return static_cast<std::size_t>(index & (m_capacity - 1));
+        }
+    };
+
+    alignas(cache_line_size) std::atomic<std::int64_t> m_top{0};     ///< Index of the oldest item, used by thieves
+    alignas(cache_line_size) std::atomic<std::int64_t> m_bottom{0};  ///< Index behind the newest item
+    std::atomic<Buffer*> m_buffer{nullptr};                          ///< Currently used buffer
+    std::vector<std::unique_ptr<Buffer>> m_buffers{};                ///< Current and retired buffers
+
+    /**
+     * @brief Replaces the buffer with one of twice the size
+     *
+     * @pre Must only be called by the owning thread
+     *
+     * @returns The new buffer
+     */
+    Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom) {
+        m_buffers.emplace_back(new Buffer{buffer->capacity() * 2});
+        auto* grown{m_buffers.back().get()};
+        for (auto index{top}; index < bottom; ++index) {
+            grown->store(index, buffer->load(index));
+        }
+        m_buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_CHASE_LEV_DEQUE_HPP_
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_CPU_TOPOLOGY_HPP_
+#define POOL_PARTY_DETAIL_CPU_TOPOLOGY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Position of a logical CPU within the machine
+ */
+struct CpuInfo {
+    std::size_t cpu;      ///< Index of the logical CPU as used by the operating system
+    std::size_t core;     ///< Physical core of the CPU, hyper threads of a core share it
+    std::size_t package;  ///< Socket of the CPU
+};
+
+/**
+ * @brief Lists the logical CPUs the process is allowed to run on
+ *
+ * On Linux the affinity mask of the process is respected, so CPUs excluded by taskset or cgroups
+ * are not listed. Other platforms list all hardware threads.
+ *
+ * @returns Ascending indices of the usable CPUs
+ */
+inline std::vector<std::size_t> availableCpus() {
+    std::vector<std::size_t> cpus{};
+#if defined(__linux__)
+    cpu_set_t cpu_set{};
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        for (std::size_t cpu{0}; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpu_set)) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+#endif
+    for (std::size_t cpu{0}; cpu < std::thread::hardware_concurrency(); ++cpu) {
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/**
+ * @brief Reads a single number from a sysfs file
+ *
+ * @param path Path of the file
+ * @param fallback Value which is returned when the file can't be read
+ *
+ * @returns Number stored in the file or fallback
+ */
+inline std::size_t readSysfsNumber(const std::string& path, std::size_t fallback) {
+    std::ifstream file{path};
+    std::size_t number{0};
+    if (file >> number) {
+        return number;
+    }
+    return fallback;
+}
+
+/**
+ * @brief Reads the core and package of CPUs from sysfs
+ *
+ * CPUs without topology information are treated as separate cores of package zero.
+ *
+ * @param cpus Indices of the CPUs to look up
+ * @param sysfs_cpu_path Directory which contains the cpuN directories
+ *
+ * @returns Topology of the CPUs in the order of cpus
+ */
+inline std::vector<CpuInfo> readCpuTopology(const std::vector<std::size_t>& cpus = availableCpus(),
+                                            const std::string& sysfs_cpu_path = "/sys/devices/system/cpu") {
+    std::vector<CpuInfo> topology{};
+    topology.reserve(cpus.size());
+    for (const auto cpu : cpus) {
+        const auto topology_path{sysfs_cpu_path + "/cpu" + std::to_string(cpu) + "/topology/"};
+        topology.push_back(CpuInfo{cpu, readSysfsNumber(topology_path + "core_id", cpu),
+                                   readSysfsNumber(topology_path + "physical_package_id", 0)});
+    }
+    return topology;
+}
+
+/**
+ * @brief Orders CPUs so that consecutive threads share caches
+ *
+ * Hyper threads of a core come first, then the cores of a package, then the next package.
+ *
+ * @param topology CPUs to order
+ *
+ * @returns CPU indices in compact order
+ */
+inline std::vector<std::size_t> compactCpuOrder(std::vector<CpuInfo> topology) {
+    std::sort(topology.begin(), topology.end(), [](const CpuInfo& lhs, const CpuInfo& rhs) {
+        if (lhs.package != rhs.package) {
+            return lhs.package < rhs.package;
+        }
+        if (lhs.core != rhs.core) {
+            return lhs.core < rhs.core;
+        }
+        return lhs.cpu < rhs.cpu;
+    });
+
+    std::vector<std::size_t> cpus{};
+    cpus.reserve(topology.size());
+    for (const auto& cpu_info : topology) {
+        cpus.push_back(cpu_info.cpu);
+    }
+    return cpus;
+}
+
+/**
+ * @brief Orders CPUs so that consecutive threads share as few resources as possible
+ *
+ * Consecutive threads alternate between the packages and use one hyper thread of every core
+ * before the sibling hyper threads are used.
+ *
+ * @param topology CPUs to order
+ *
+ * @returns CPU indices in scatter order
+ */
+inline std::vector<std::size_t> scatterCpuOrder(const std::vector<CpuInfo>& topology) {
+    // Package -> core -> hyper threads, all in ascending order
+    std::map<std::size_t, std::map<std::size_t, std::vector<std::size_t>>> packages{};
+    for (const auto& cpu_info : topology) {
+        packages[cpu_info.package][cpu_info.core].push_back(cpu_info.cpu);
+    }
+
+    std::vector<std::vector<std::vector<std::size_t>>> cores_per_package{};
+    for (auto& package : packages) {
+        cores_per_package.emplace_back();
+        for (auto& core : package.second) {
+            std::sort(core.second.begin(), core.second.end());
+            cores_per_package.back().push_back(core.second);
+        }
+    }
+
+    std::vector<std::size_t> cpus{};
+    cpus.reserve(topology.size());
+    for (std::size_t hyper_thread{0}; cpus.size() < topology.size(); ++hyper_thread) {
+        for (std::size_t core{0}; core < topology.size(); ++core) {
+            for (const auto& cores : cores_per_package) {
+                if (core < cores.size() && hyper_thread < cores[core].size()) {
+                    cpus.push_back(cores[core][hyper_thread]);
+                }
+            }
+        }
+    }
+    return cpus;
+}
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_CPU_TOPOLOGY_HPP_
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_FIFO_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_FIFO_QUEUE_HPP_
+
+#include "queue_tags.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Task queue with fifo strategy
+ *
+ * All worker threads share a single queue. The queue itself is not thread safe, the thread pool
+ * guards every access with the mutex of its sync object.
+ *
+ * The queue is unbounded by default. With a capacity, pushes only take as many tasks as fit and
+ * the thread pool applies backpressure to the producers.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class FifoQueue {
+public:
+    using synchronization_tag = LockedQueueTag;
+
+    static constexpr std::size_t unbounded{std::numeric_limits<std::size_t>::max()};  ///< Capacity without limit
+
+    /**
+     * @brief Constructor of FifoQueue
+     *
+     * @param number_of_workers Unused, all workers share the same queue
+     * @param capacity Maximum number of queued tasks
+     */
+    explicit FifoQueue(std::size_t /*number_of_workers*/, std::size_t capacity = unbounded) : m_capacity{capacity} {}
+
+    /**
+     * @brief Appends a task to the end of the queue
+     *
+     * @param task Task which is moved into the queue, it is left untouched when the queue is full
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns True if the task was queued, false if the queue is full
+     */
+    bool push(Task&& task, std::size_t /*worker_index*/) {
+        if (m_tasks.size() >= m_capacity) {
+            return false;
+        }
+
+        m_tasks.push_back(std::move(task));
+        return true;
+    }
+
+    /**
+     * @brief Appends a range of tasks to the end of the queue
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks which fit are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns Iterator to the first task which was not queued, last if all tasks were queued
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t /*worker_index*/) {
+        using DifferenceType = typename std::iterator_traits<Iterator>::difference_type;
+
+        const auto free_slots{m_capacity - std::min(m_tasks.size(), m_capacity)};
+        const auto number_of_tasks{std::min(static_cast<std::size_t>(std::distance(first, last)), free_slots)};
+        const auto end_of_pushed{std::next(first, static_cast<DifferenceType>(number_of_tasks))};
+
+        m_tasks.insert(m_tasks.end(), std::make_move_iterator(first), std::make_move_iterator(end_of_pushed));
+        return end_of_pushed;
+    }
+
+    /**
+     * @brief Removes the oldest task from the queue
+     *
+     * @param task Receives the oldest task when the queue is not empty
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns True if a task was removed, false if the queue is empty
+     */
+    bool tryPop(Task& task, std::size_t /*worker_index*/) {
+        if (m_tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, false otherwise
+     */
+    bool empty() const {
+        return m_tasks.empty();
+    }
+
+    /**
+     * @brief Number of queued tasks
+     *
+     * @returns Number of tasks in the queue
+     */
+    std::size_t size() const {
+        return m_tasks.size();
+    }
+
+    /**
+     * @brief Maximum number of queued tasks
+     *
+     * @returns Capacity of the queue, unbounded if there is no limit
+     */
+    std::size_t capacity() const {
+        return m_capacity;
+    }
+
+private:
+    std::size_t m_capacity;      ///< Maximum number of queued tasks
+    std::deque<Task> m_tasks{};  ///< Queued tasks, the oldest one is in front
+};
+
+template<typename Task>
+constexpr std::size_t FifoQueue<Task>::unbounded;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_FIFO_QUEUE_HPP_
@@ -0,0 +1,475 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_FUTURE_HPP_
+#define POOL_PARTY_DETAIL_FUTURE_HPP_
+
+#include "task.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Stored result of futures without value
+ */
+struct VoidResult {};
+
+/**
+ * @brief Maps the result type of a future to the type which is stored in its state
+ */
+template<typename R>
+struct FutureStorage {
+    using type = R;
+};
+
+template<>
+struct FutureStorage<void> {
+    using type = VoidResult;
+};
+
+/**
+ * @brief Schedules a continuation on an executor, receives the executor as untyped pointer
+ */
+using ContinuationScheduler = void (*)(void*, Task&&);
+
+/**
+ * @brief Shared state of a pool_party::detail::Future
+ *
+ * The state is a small atomic state machine. The producer publishes the result by switching to
+ * ready, a single continuation is registered by switching to continued. Whoever comes second
+ * runs the continuation, so neither side takes a lock. Blocking waiters register a continuation
+ * which wakes them up, mutex and condition variable only exist while someone blocks.
+ *
+ * @tparam T Type of the stored result
+ */
+template<typename T>
+class FutureState {
+public:
+    /**
+     * @brief Constructor of FutureState
+     *
+     * @param scheduler Schedules continuations on the executor, nullptr runs them inline
+     * @param executor Executor which is passed to the scheduler
+     */
+    FutureState(ContinuationScheduler scheduler, void* executor) : m_scheduler{scheduler}, m_executor{executor} {}
+    FutureState(const FutureState&)            = delete;
+    FutureState(FutureState&&)                 = delete;
+    FutureState& operator=(const FutureState&) = delete;
+    FutureState& operator=(FutureState&&)      = delete;
+
+    ~FutureState() {
+        if (m_has_value) {
+            reinterpret_cast<T*>(&m_storage)->~T();
+        }
+    }
+
+    /**
+     * @brief Stores the result and runs a registered continuation
+     *
+     * @pre Must be called at most once, together with setException
+     */
+    template<typename... Args>
+    void setValue(Args&&... args) {
+        new (&m_storage) T(std::forward<Args>(args)...);
+        m_has_value = true;
+        publish();
+    }
+
+    /**
+     * @brief Stores an exception and runs a registered continuation
+     *
+     * @pre Must be called at most once, together with setValue
+     */
+    void setException(std::exception_ptr exception) {
+        m_exception = std::move(exception);
+        publish();
+    }
+
+    /**
+     * @brief Registers the single continuation of the state
+     *
+     * The continuation runs as soon as the result is published, immediately if it already is.
+     *
+     * @param continuation Callable which is called when the state is ready
+     * @param run_inline True to run the continuation on the publishing thread, false to schedule it
+     */
+    void onReady(Task&& continuation, bool run_inline) {
+        m_continuation = std::move(continuation);
+        m_run_inline   = run_inline;
+
+        auto expected{Status::pending};
+        if (!m_status.compare_exchange_strong(expected, Status::continued, std::memory_order_acq_rel)) {
+            runContinuation();
+        }
+    }
+
+    /**
+     * @brief Blocks until the result is published
+     *
+     * @pre No continuation must be registered
+     */
+    void wait() {
+        if (isReady()) {
+            return;
+        }
+
+        std::mutex mtx{};
+        std::condition_variable cv{};
+        bool is_ready{false};
+        onReady(Task{[&mtx, &cv, &is_ready]() {
+                    std::lock_guard<std::mutex> lg{mtx};
+                    is_ready = true;
+                    cv.notify_one();
+                }},
+                true);
+
+        std::unique_lock<std::mutex> ul{mtx};
+        cv.wait(ul, [&is_ready]() { return is_ready; });
+    }
+
+    bool isReady() const {
+        return m_status.load(std::memory_order_acquire) == Status::ready;
+    }
+
+    /**
+     * @brief Returns the stored value or rethrows the stored exception
+     *
+     * @pre The state must be ready
+     */
+    T& get() {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+        return *reinterpret_cast<T*>(&m_storage);
+    }
+
+    /**
+     * @brief Returns the stored exception, an empty pointer if a value was stored
+     *
+     * @pre The state must be ready
+     */
+    const std::exception_ptr& getException() const {
+        return m_exception;
+    }
+
+    ContinuationScheduler getScheduler() const {
+        return m_scheduler;
+    }
+
+    void* getExecutor() const {
+        return m_executor;
+    }
+
+private:
+    enum class Status : std::uint8_t { pending, continued, ready };
+
+    using StorageType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    const ContinuationScheduler m_scheduler;        ///< Schedules continuations, nullptr runs them inline
+    void* const m_executor;                         ///< Executor which is passed to the scheduler
+    std::atomic<Status> m_status{Status::pending};  ///< Progress of the state machine
+    StorageType m_storage;                          ///< Holds the value once it was published
+    bool m_has_value{false};                        ///< True if a value was constructed in the storage
+    std::exception_ptr m_exception{};               ///< Holds the exception once it was published
+    Task m_continuation{};                          ///< Continuation which runs when the state is ready
+    bool m_run_inline{false};                       ///< True if the continuation runs on the publishing thread
+
+    void publish() {
+        if (m_status.exchange(Status::ready, std::memory_order_acq_rel) == Status::continued) {
+            runContinuation();
+        }
+    }
+
+    void runContinuation() {
+        // The continuation usually owns the state, releasing it here breaks the cycle
+        Task continuation{std::move(m_continuation)};
+        if (m_run_inline || m_scheduler == nullptr) {
+            continuation();
+            return;
+        }
+        m_scheduler(m_executor, std::move(continuation));
+    }
+};
+
+/**
+ * @brief Creates the exception which is published for tasks that were dropped without running
+ *
+ * Before C++17 std::future_error can't be constructed portably, so the exception is taken from
+ * an abandoned std::promise.
+ */
+inline std::exception_ptr makeBrokenPromise() {
+    std::future<void> abandoned{std::promise<void>{}.get_future()};
+    try {
+        abandoned.get();
+    } catch (const std::future_error&) {
+        return std::current_exception();
+    }
+    return {};
+}
+
+template<typename T, typename Callable, typename... Args>
+void publishResult(FutureState<T>& state, Callable& callable, std::true_type /*returns_void*/, Args&&... args) {
+    callable(std::forward<Args>(args)...);
+    state.setValue();
+}
+
+template<typename T, typename Callable, typename... Args>
+void publishResult(FutureState<T>& state, Callable& callable, std::false_type /*returns_void*/, Args&&... args) {
+    state.setValue(callable(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Calls a callable and publishes its result or exception in a state
+ *
+ * @param state State which receives the result
+ * @param callable Callable which is called with the arguments
+ * @param args Arguments which are passed to the callable
+ */
+template<typename T, typename Callable, typename... Args>
+void fulfil(FutureState<T>& state, Callable& callable, Args&&... args) {
+    using ReturnsVoid = std::is_void<decltype(callable(std::forward<Args>(args)...))>;
+    try {
+        publishResult(state, callable, ReturnsVoid{}, std::forward<Args>(args)...);
+    } catch (...) {
+        state.setException(std::current_exception());
+    }
+}
+
+/**
+ * @brief Result type of a continuation which consumes the result of a Future<R>
+ */
+template<typename R, typename Continuation>
+struct ContinuationResult {
+    using type = typename std::result_of<typename std::decay<Continuation>::type&(R&&)>::type;
+};
+
+template<typename Continuation>
+struct ContinuationResult<void, Continuation> {
+    using type = typename std::result_of<typename std::decay<Continuation>::type&()>::type;
+};
+
+struct FutureAccess;
+
+/**
+ * @brief Future whose result can be consumed by continuations instead of blocking
+ *
+ * Continuations which are attached with then() are scheduled on the thread pool which produced
+ * the result as soon as it is ready, no thread blocks in the meantime. A future is move-only and
+ * owns a single continuation, then() and get() consume it.
+ *
+ * The thread pool has to outlive futures which receive continuations. When the pool is already
+ * shut down, continuations run on the thread which publishes the result.
+ *
+ * @tparam R Type of the result
+ */
+template<typename R>
+class Future {
+    friend struct FutureAccess;
+
+public:
+    using StateType = FutureState<typename FutureStorage<R>::type>;  ///< Type of the shared state
+
+    /**
+     * @brief Constructor of an invalid future
+     */
+    Future() = default;
+
+    /**
+     * @brief Constructor of Future
+     *
+     * @param state Shared state which receives the result
+     */
+    explicit Future(std::shared_ptr<StateType> state) : m_state{std::move(state)} {}
+
+    Future(const Future&)            = delete;
+    Future& operator=(const Future&) = delete;
+    Future(Future&&)                 = default;
+    Future& operator=(Future&&)      = default;
+    ~Future()                        = default;
+
+    /**
+     * @brief Checks if the future refers to a shared state
+     *
+     * @returns False for default constructed futures and after get or then, true otherwise
+     */
+    bool valid() const {
+        return m_state != nullptr;
+    }
+
+    /**
+     * @brief Checks if the result is available without blocking
+     *
+     * @pre The future must be valid
+     */
+    bool isReady() const {
+        return m_state->isReady();
+    }
+
+    /**
+     * @brief Blocks until the result is available
+     *
+     * @pre The future must be valid
+     */
+    void wait() const {
+        m_state->wait();
+    }
+
+    /**
+     * @brief Waits for the result and returns it
+     *
+     * The future is invalid afterwards.
+     *
+     * @pre The future must be valid
+     *
+     * @returns The result of the task
+     *
+     * @exception Rethrows the exception of the task
+     */
+    R get() {
+        const auto state{std::move(m_state)};
+        state->wait();
+        return takeResult(*state, std::is_void<R>{});
+    }
+
+    /**
+     * @brief Attaches a continuation which receives the result
+     *
+     * The continuation is scheduled on the thread pool when the result is ready. If the task
+     * failed, the continuation is skipped and the exception is passed to the returned future.
+     * The future is invalid afterwards.
+     *
+     * @pre The future must be valid
+     *
+     * @tparam Continuation Type of the callable, called with the result or without argument for Future<void>
+     * @tparam U Automatically generated result type of the continuation
+     *
+     * @param continuation The callable which consumes the result
+     *
+     * @returns Future with the result of the continuation
+     */
+    template<typename Continuation, typename U = typename ContinuationResult<R, Continuation>::type>
+    Future<U> then(Continuation&& continuation) {
+        using NextStateType = typename Future<U>::StateType;
+        using CallableType  = typename std::decay<Continuation>::type;
+
+        const auto state{std::move(m_state)};
+        auto next_state{std::make_shared<NextStateType>(state->getScheduler(), state->getExecutor())};
+        state->onReady(Task{ContinuationTask<NextStateType, CallableType>{
+                       state, next_state, std::forward<Continuation>(continuation)}},
+                       false);
+
+        return Future<U>{std::move(next_state)};
+    }
+
+private:
+    /**
+     * @brief Task which passes the result of a ready state to a continuation
+     *
+     * @tparam NextState Type of the state which receives the result of the continuation
+     * @tparam Callable Type of the continuation
+     */
+    template<typename NextState, typename Callable>
+    class ContinuationTask {
+    public:
+        template<typename Continuation>
+        ContinuationTask(std::shared_ptr<StateType> state,
+                         std::shared_ptr<NextState> next_state,
+                         Continuation&& continuation) :
+                m_state{std::move(state)},
+                m_next_state{std::move(next_state)},
+                m_callable(std::forward<Continuation>(continuation)) {}
+
+        ContinuationTask(ContinuationTask&&) = default;
+
+        /**
+         * @brief Publishes a broken promise if the continuation was dropped without running
+         */
+        ~ContinuationTask() {
+            if (m_next_state) {
+                m_next_state->setException(makeBrokenPromise());
+            }
+        }
+
+        void operator()() {
+            const auto next_state{std::move(m_next_state)};
+            if (m_state->getException()) {
+                next_state->setException(m_state->getException());
+                return;
+            }
+            continueWith(*m_state, *next_state, m_callable, std::is_void<R>{});
+        }
+
+    private:
+        std::shared_ptr<StateType> m_state;       ///< Ready state whose result is consumed
+        std::shared_ptr<NextState> m_next_state;  ///< State which receives the result, nullptr once published
+        Callable m_callable;                      ///< The continuation
+    };
+
+    std::shared_ptr<StateType> m_state{};  ///< Shared state which receives the result
+
+    static R takeResult(StateType& state, std::false_type /*is_void*/) {
+        return std::move(state.get());
+    }
+
+    static void takeResult(StateType& state, std::true_type /*is_void*/) {
+        state.get();
+    }
+
+    template<typename NextState, typename Callable>
+    static void continueWith(StateType& state, NextState& next_state, Callable& callable, std::false_type /*is_void*/) {
+        fulfil(next_state, callable, std::move(state.get()));
+    }
+
+    template<typename NextState, typename Callable>
+    static void continueWith(StateType&, NextState& next_state, Callable& callable, std::true_type /*is_void*/) {
+        fulfil(next_state, callable);
+    }
+};
+
+/**
+ * @brief Grants combinators of futures access to their shared states
+ */
+struct FutureAccess {
+    /**
+     * @brief Takes the shared state out of a future, the future is invalid afterwards
+     */
+    template<typename R>
+    static std::shared_ptr<typename Future<R>::StateType> releaseState(Future<R>& future) {
+        return std::move(future.m_state);
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_FUTURE_HPP_
@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_HILL_CLIMBING_HPP_
+#define POOL_PARTY_DETAIL_HILL_CLIMBING_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Reasons of the hill climbing controller for choosing a worker target
+ */
+enum class ConcurrencyReason : std::uint8_t {
+    baseline_measured,    ///< Throughput of the current target was measured, a neighbouring target is probed next
+    throughput_improved,  ///< The probed target improved the throughput and is kept
+    throughput_declined   ///< The probed target didn't improve the throughput, the previous target is restored
+};
+
+/**
+ * @brief Decision of the hill climbing controller after a sampling interval
+ */
+struct ConcurrencyDecision {
+    std::size_t previous_target;  ///< Worker target during the sample
+    std::size_t target;           ///< Worker target for the next sample
+    double throughput;            ///< Completed tasks per second during the sample
+    double baseline_throughput;   ///< Throughput the sample was compared with, zero for baseline measurements
+    ConcurrencyReason reason;     ///< Why the target was chosen
+};
+
+/**
+ * @brief Hill climbing controller which searches the worker target with the highest throughput
+ *
+ * The controller alternates between measuring the throughput of the current target and probing
+ * a neighbouring target. A probe is kept if it improves the throughput by more than the minimum
+ * improvement, then the controller keeps climbing in the same direction. Otherwise the
+ * previous target is restored and the next probe goes into the opposite direction. Since every
+ * probe is compared with a fresh measurement, the controller follows an optimum which drifts
+ * over time.
+ *
+ * The controller isn't thread safe, the thread pool only updates it from one thread at a time.
+ */
+class HillClimbing {
+public:
+    /**
+     * @brief Constructor of HillClimbing
+     *
+     * @param min_target Lower bound of the worker target
+     * @param max_target Upper bound of the worker target
+     * @param initial_target Worker target of the first sample, clamped to the bounds
+     * @param min_improvement Relative throughput gain which keeps a probe
+     */
+    HillClimbing(std::size_t min_target,
+                 std::size_t max_target,
+                 std::size_t initial_target,
+                 double min_improvement = 0.05) :
+            m_min_target{min_target},
+            m_max_target{std::max(min_target, max_target)},
+            m_target{std::min(std::max(initial_target, m_min_target), m_max_target)},
+            m_min_improvement{min_improvement} {}
+
+    /**
+     * @brief Chooses the worker target for the next sample
+     *
+     * @param completed_tasks Number of tasks which were completed during the sample
+     * @param elapsed Duration of the sample
+     *
+     * @returns The decision with the new worker target and its reason
+     */
+    ConcurrencyDecision update(std::size_t completed_tasks, std::chrono::nanoseconds elapsed) {
+        const auto seconds{std::chrono::duration<double>{elapsed}.count()};
+        const auto throughput{seconds > 0.0 ? static_cast<double>(completed_tasks) / seconds : 0.0};
+
+        ConcurrencyDecision decision{m_target, m_target, throughput, 0.0, ConcurrencyReason::baseline_measured};
+        if (!m_is_probing) {
+            m_baseline = throughput;
+            probe();
+        } else if (throughput > m_baseline * (1.0 + m_min_improvement)) {
+            decision.baseline_throughput = m_baseline;
+            decision.reason              = ConcurrencyReason::throughput_improved;
+            m_baseline                   = throughput;
+            climb();
+        } else {
+            decision.baseline_throughput = m_baseline;
+            decision.reason              = ConcurrencyReason::throughput_declined;
+            m_target                     = m_probed_from;
+            m_is_upwards                 = !m_is_upwards;
+            m_is_probing                 = false;
+        }
+        decision.target = m_target;
+        return decision;
+    }
+
+    /**
+     * @brief Getter for the current worker target
+     */
+    std::size_t getTarget() const {
+        return m_target;
+    }
+
+private:
+    std::size_t m_min_target;      ///< Lower bound of the worker target
+    std::size_t m_max_target;      ///< Upper bound of the worker target
+    std::size_t m_target;          ///< Current worker target
+    double m_min_improvement;      ///< Relative throughput gain which keeps a probe
+    std::size_t m_probed_from{0};  ///< Target which is restored if the probe doesn't improve the throughput
+    double m_baseline{0.0};        ///< Throughput which the probe has to beat
+    bool m_is_probing{false};      ///< Whether the current target is a probe
+    bool m_is_upwards{true};       ///< Direction of the next probe
+
+    bool isAtBound() const {
+        return m_is_upwards ? m_target == m_max_target : m_target == m_min_target;
+    }
+
+    /**
+     * @brief Probes the neighbouring target in the probing direction, turns around at the bounds
+     *
+     * Without room in either direction, the target is measured again in the next sample.
+     */
+    void probe() {
+        if (isAtBound()) {
+            m_is_upwards = !m_is_upwards;
+        }
+        if (isAtBound()) {
+            m_is_probing = false;
+            return;
+        }
+
+        m_probed_from = m_target;
+        m_target      = m_is_upwards ? m_target + 1 : m_target - 1;
+        m_is_probing  = true;
+    }
+
+    /**
+     * @brief Continues an improving probe in the same direction
+     *
+     * At a bound, the improved target is measured again and the next probe goes back.
+     */
+    void climb() {
+        if (!isAtBound()) {
+            probe();
+            return;
+        }
+
+        m_is_upwards = !m_is_upwards;
+        m_is_probing = false;
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_HILL_CLIMBING_HPP_
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_IN_FLIGHT_COUNTER_HPP_
+#define POOL_PARTY_DETAIL_IN_FLIGHT_COUNTER_HPP_
+
+#include "cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Counts operations which are in flight without a shared cache line per operation
+ *
+ * Started and finished operations are counted on stripes, one per worker and a few for threads
+ * outside of the pool, each on its own cache line. The counts only grow, so the counter is zero
+ * when the finished operations of all stripes, which are summed first, match the started ones.
+ * An operation starts before it finishes, so a match means that no operation was in flight at
+ * the moment between both sums.
+ *
+ * Only threads which wait for the counter to drop to zero touch a shared cache line. They
+ * register as waiters, so finishing threads check for zero only while somebody waits.
+ */
+class InFlightCounter {
+public:
+    /**
+     * @brief Constructor of InFlightCounter
+     *
+     * @param number_of_workers Number of workers, each of them gets its own stripe
+     */
+    explicit InFlightCounter(std::size_t number_of_workers) : m_stripes(number_of_workers + external_stripes) {}
+
+    /**
+     * @brief Counts started operations
+     *
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     * @param number_of_operations Number of started operations
+     */
+    void start(std::size_t worker_index, std::size_t number_of_operations) {
+        stripe(worker_index).started.fetch_add(number_of_operations);
+    }
+
+    /**
+     * @brief Counts finished operations
+     *
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     * @param number_of_operations Number of finished operations
+     *
+     * @returns True if a waiter is registered, the caller checks for zero and wakes it up then
+     */
+    bool finish(std::size_t worker_index, std::size_t number_of_operations) {
+        // Sequentially consistent with the registration of waiters, either the waiter sees the
+        // finished operations or the caller sees the waiter
+        stripe(worker_index).finished.fetch_add(number_of_operations);
+        return m_waiters.load() != 0;
+    }
+
+    /**
+     * @brief Checks if no operation is in flight
+     *
+     * @returns True if all started operations are finished, false otherwise
+     */
+    bool isZero() const {
+        std::size_t finished{0};
+        for (const auto& counter_stripe : m_stripes) {
+            finished += counter_stripe.finished.load();
+        }
+
+        std::size_t started{0};
+        for (const auto& counter_stripe : m_stripes) {
+            started += counter_stripe.started.load();
+        }
+        return started == finished;
+    }
+
+    /**
+     * @brief Registers a thread which waits for the counter to drop to zero
+     */
+    void addWaiter() {
+        ++m_waiters;
+    }
+
+    /**
+     * @brief Unregisters a waiting thread
+     */
+    void removeWaiter() {
+        --m_waiters;
+    }
+
+private:
+    static constexpr std::size_t external_stripes{8};  ///< Stripes of threads which are no workers
+
+    /**
+     * @brief Counts of a single stripe, on a separate cache line to avoid false sharing
+     */
+    struct alignas(cache_line_size) Stripe {
+        std::atomic<std::size_t> started{0};   ///< Started operations, only grows
+        std::atomic<std::size_t> finished{0};  ///< Finished operations, only grows
+    };
+
+    std::vector<Stripe, CacheAlignedAllocator<Stripe>> m_stripes;  ///< Stripes of the workers and other threads
+    std::atomic<std::size_t> m_waiters{0};                         ///< Threads which wait for zero
+
+    Stripe& stripe(std::size_t worker_index) {
+        const auto number_of_workers{m_stripes.size() - external_stripes};
+        if (worker_index < number_of_workers) {
+            return m_stripes[worker_index];
+        }
+        const auto thread_hash{std::hash<std::thread::id>{}(std::this_thread::get_id())};
+        return m_stripes[number_of_workers + thread_hash % external_stripes];
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_IN_FLIGHT_COUNTER_HPP_
@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_LIFO_SLOT_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_LIFO_SLOT_QUEUE_HPP_
+
+#include "fifo_queue.hpp"
+#include "queue_tags.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Task queue with a shared fifo queue and a lifo slot per worker
+ *
+ * A single task which is pushed by a worker goes to the next task slot of this worker, so the
+ * follow-up of a task runs next on the same thread while its data is still in the caches. A task
+ * which already occupied the slot gives way and is appended to the shared fifo queue. Tasks from
+ * outside of the pool and ranges of tasks go to the shared queue as well.
+ *
+ * Other workers steal from a slot once the task waited there for the steal delay. The owner is
+ * usually done with its current task by then, while a task whose owner blocks still makes
+ * progress. To prevent a chain of follow-ups from starving the shared queue, a worker takes a
+ * task from the shared queue after max_slot_streak tasks from its slot. While only reserved slot
+ * tasks are queued, reservedFor tells idle workers how long to park before they can steal.
+ *
+ * Like pool_party::detail::FifoQueue, the queue is not thread safe. The thread pool guards every
+ * access with the mutex of its sync object.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class LifoSlotQueue {
+public:
+    using synchronization_tag = LockedQueueTag;
+
+    static constexpr std::chrono::microseconds steal_delay{20};  ///< Time a slot is reserved for its owner
+    static constexpr std::size_t max_slot_streak{16};            ///< Slot tasks in a row before the shared queue
+
+    /**
+     * @brief Constructor of LifoSlotQueue
+     *
+     * @param number_of_workers Number of workers, each of them gets its own slot
+     * @param capacity Maximum number of queued tasks, including the tasks in the slots
+     */
+    explicit LifoSlotQueue(std::size_t number_of_workers, std::size_t capacity = FifoQueue<Task>::unbounded) :
+            m_slots(number_of_workers), m_shared_tasks{number_of_workers}, m_capacity{capacity} {}
+
+    /**
+     * @brief Pushes a task either to the slot of a worker or to the shared queue
+     *
+     * @param task Task which is moved into the queue, it is left untouched when the queue is full
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns True if the task was queued, false if the queue is full
+     */
+    bool push(Task&& task, std::size_t worker_index) {
+        return push(&task, &task + 1, worker_index) != &task;
+    }
+
+    /**
+     * @brief Pushes a range of tasks
+     *
+     * A range with a single task from a worker goes to its slot, all other tasks go to the shared
+     * queue.
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks which fit are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Iterator to the first task which was not queued, last if all tasks were queued
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t worker_index) {
+        using DifferenceType = typename std::iterator_traits<Iterator>::difference_type;
+
+        const auto free_slots{m_capacity - std::min(size(), m_capacity)};
+        if (first == last || free_slots == 0) {
+            return first;
+        }
+
+        if (worker_index < m_slots.size() && std::next(first) == last) {
+            pushToSlot(std::move(*first), worker_index);
+            return last;
+        }
+
+        const auto number_of_tasks{std::min(static_cast<std::size_t>(std::distance(first, last)), free_slots)};
+        return m_shared_tasks.push(first, std::next(first, static_cast<DifferenceType>(number_of_tasks)), worker_index);
+    }
+
+    /**
+     * @brief Takes a task from the queue
+     *
+     * Workers try their own slot first, then the shared queue and steal from the slots of other
+     * workers as last resort. Threads outside of the pool skip the first step.
+     *
+     * @param task Receives the taken task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns True if a task was taken, false if no task is available yet
+     */
+    bool tryPop(Task& task, std::size_t worker_index) {
+        if (worker_index < m_slots.size() && popOwnSlot(task, worker_index)) {
+            return true;
+        }
+
+        if (m_shared_tasks.tryPop(task, worker_index)) {
+            if (worker_index < m_slots.size()) {
+                m_slots[worker_index].streak = 0;
+            }
+            return true;
+        }
+
+        return stealSlot(task, worker_index);
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, false otherwise
+     */
+    bool empty() const {
+        return m_occupied_slots == 0 && m_shared_tasks.empty();
+    }
+
+    /**
+     * @brief Time until a worker may take a task while all queued tasks are reserved for others
+     *
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Zero if the worker can take a task or no task is queued, the remaining steal delay
+     *          of the oldest slot task of another worker otherwise
+     */
+    std::chrono::steady_clock::duration reservedFor(std::size_t worker_index) const {
+        const auto no_reservation{std::chrono::steady_clock::duration::zero()};
+        if (m_occupied_slots == 0 || !m_shared_tasks.empty() ||
+            (worker_index < m_slots.size() && m_slots[worker_index].is_occupied)) {
+            return no_reservation;
+        }
+
+        auto oldest_push{std::chrono::steady_clock::time_point::max()};
+        for (const auto& slot : m_slots) {
+            if (slot.is_occupied) {
+                oldest_push = std::min(oldest_push, slot.pushed_at);
+            }
+        }
+        return std::max(oldest_push + steal_delay - std::chrono::steady_clock::now(), no_reservation);
+    }
+
+    /**
+     * @brief Number of queued tasks
+     *
+     * @returns Number of tasks in the shared queue and the slots
+     */
+    std::size_t size() const {
+        return m_occupied_slots + m_shared_tasks.size();
+    }
+
+    /**
+     * @brief Maximum number of queued tasks
+     *
+     * @returns Capacity of the queue including the slots, FifoQueue::unbounded if there is no limit
+     */
+    std::size_t capacity() const {
+        return m_capacity;
+    }
+
+private:
+    /**
+     * @brief Next task slot of a single worker
+     */
+    struct Slot {
+        Task task{};                                        ///< Task which runs next on the owner
+        bool is_occupied{false};                            ///< Whether the slot holds a task
+        std::chrono::steady_clock::time_point pushed_at{};  ///< Point in time the task was pushed
+        std::size_t streak{0};                              ///< Slot tasks the owner took in a row
+    };
+
+    std::vector<Slot> m_slots;        ///< Slot of each worker
+    FifoQueue<Task> m_shared_tasks;   ///< Tasks which are shared by all workers
+    std::size_t m_capacity;           ///< Maximum number of queued tasks
+    std::size_t m_occupied_slots{0};  ///< Number of slots which hold a task
+
+    void pushToSlot(Task&& task, std::size_t worker_index) {
+        auto& slot{m_slots[worker_index]};
+        if (slot.is_occupied) {
+            m_shared_tasks.push(std::move(slot.task), worker_index);
+        } else {
+            slot.is_occupied = true;
+            ++m_occupied_slots;
+        }
+
+        slot.task      = std::move(task);
+        slot.pushed_at = std::chrono::steady_clock::now();
+    }
+
+    bool popOwnSlot(Task& task, std::size_t worker_index) {
+        auto& slot{m_slots[worker_index]};
+        if (!slot.is_occupied || (slot.streak >= max_slot_streak && !m_shared_tasks.empty())) {
+            return false;
+        }
+
+        ++slot.streak;
+        take(task, slot);
+        return true;
+    }
+
+    bool stealSlot(Task& task, std::size_t worker_index) {
+        if (m_occupied_slots == 0) {
+            return false;
+        }
+
+        // Start behind the thief to spread the thieves across the slots
+        const auto now{std::chrono::steady_clock::now()};
+        for (std::size_t attempt{1}; attempt <= m_slots.size(); ++attempt) {
+            const auto victim_index{(worker_index + attempt) % m_slots.size()};
+            auto& slot{m_slots[victim_index]};
+            if (victim_index != worker_index && slot.is_occupied && now - slot.pushed_at >= steal_delay) {
+                take(task, slot);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void take(Task& task, Slot& slot) {
+        task             = std::move(slot.task);
+        slot.task        = Task{};
+        slot.is_occupied = false;
+        --m_occupied_slots;
+    }
+};
+
+template<typename Task>
+constexpr std::chrono::microseconds LifoSlotQueue<Task>::steal_delay;
+
+template<typename Task>
+constexpr std::size_t LifoSlotQueue<Task>::max_slot_streak;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_LIFO_SLOT_QUEUE_HPP_
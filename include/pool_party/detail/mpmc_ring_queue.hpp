@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_MPMC_RING_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_MPMC_RING_QUEUE_HPP_
+
+#include "cache_line.hpp"
+#include "queue_tags.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Lock-free bounded task queue with fifo strategy
+ *
+ * Implementation of the bounded multi producer multi consumer queue by Dmitry Vyukov. Every slot
+ * of the ring buffer carries a sequence number which tells producers and consumers whether the slot
+ * is free or filled in the current round. Producers and consumers only contend on a single atomic
+ * position each and the slots are padded to separate cache lines.
+ *
+ * Tasks are constructed in place, so pushing and popping never allocates memory.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class MpmcRingQueue {
+public:
+    using synchronization_tag = ConcurrentQueueTag;
+
+    static constexpr std::size_t default_capacity{1024};  ///< Capacity when none is passed
+
+    /**
+     * @brief Constructor of MpmcRingQueue
+     *
+     * @param number_of_workers Unused, all workers share the same queue
+     * @param capacity Maximum number of queued tasks, rounded up to the next power of two but at
+     *                 least two, otherwise the sequence numbers of a round can't be told apart
+     */
+    explicit MpmcRingQueue(std::size_t /*number_of_workers*/, std::size_t capacity = default_capacity) :
+            m_slots(roundUpToPowerOfTwo(capacity)), m_mask{m_slots.size() - 1} {
+        for (std::size_t position{0}; position < m_slots.size(); ++position) {
+            m_slots[position].sequence.store(position, std::memory_order_relaxed);
+        }
+    }
+    MpmcRingQueue(const MpmcRingQueue&)            = delete;
+    MpmcRingQueue(MpmcRingQueue&&)                 = delete;
+    MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+    MpmcRingQueue& operator=(MpmcRingQueue&&)      = delete;
+
+    /**
+     * @brief Destructor releases all tasks which were not executed
+     */
+    ~MpmcRingQueue() {
+        Task task{};
+        while (tryPop(task, no_worker_index)) {
+        }
+    }
+
+    /**
+     * @brief Appends a task to the end of the queue
+     *
+     * @param task Task which is moved into the queue, it is left untouched when the queue is full
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns True if the task was queued, false if the queue is full
+     */
+    bool push(Task&& task, std::size_t /*worker_index*/) {
+        auto position{m_enqueue_position.load(std::memory_order_relaxed)};
+        while (true) {
+            auto& slot{m_slots[position & m_mask]};
+            const auto sequence{slot.sequence.load(std::memory_order_acquire)};
+            const auto difference{static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position)};
+
+            if (difference == 0) {
+                if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    new (&slot.storage) Task{std::move(task)};
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Appends a range of tasks to the end of the queue
+     *
+     * A single compare and swap of the enqueue position reserves as many consecutive free slots as
+     * possible, so producers of large batches don't contend for every single task.
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns Iterator to the first task which was not queued because the queue is full, last if all
+     *          tasks were queued
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t /*worker_index*/) {
+        auto position{m_enqueue_position.load(std::memory_order_relaxed)};
+        while (first != last) {
+            const auto requested{static_cast<std::size_t>(std::distance(first, last))};
+            const auto reserved{countFreeSlots(position, requested)};
+
+            if (reserved == 0) {
+                const auto sequence{m_slots[position & m_mask].sequence.load(std::memory_order_acquire)};
+                if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position) < 0) {
+                    return first;
+                }
+                position = m_enqueue_position.load(std::memory_order_relaxed);
+            } else if (m_enqueue_position.compare_exchange_weak(position, position + reserved,
+                                                                std::memory_order_relaxed)) {
+                for (std::size_t offset{0}; offset < reserved; ++offset, ++first) {
+                    auto& slot{m_slots[(position + offset) & m_mask]};
+                    new (&slot.storage) Task{std::move(*first)};
+                    slot.sequence.store(position + offset + 1, std::memory_order_release);
+                }
+                position += reserved;
+            }
+        }
+        return first;
+    }
+
+    /**
+     * @brief Removes the oldest task from the queue
+     *
+     * @param task Receives the oldest task when the queue is not empty
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns True if a task was removed, false if the queue is empty
+     */
+    bool tryPop(Task& task, std::size_t /*worker_index*/) {
+        auto position{m_dequeue_position.load(std::memory_order_relaxed)};
+        while (true) {
+            auto& slot{m_slots[position & m_mask]};
+            const auto sequence{slot.sequence.load(std::memory_order_acquire)};
+            const auto difference{static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1)};
+
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    auto* stored_task{reinterpret_cast<Task*>(&slot.storage)};
+                    task = std::move(*stored_task);
+                    stored_task->~Task();
+                    slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, may be outdated when other threads modify the queue
+     */
+    bool empty() const {
+        const auto enqueue_position{m_enqueue_position.load()};
+        return enqueue_position == m_dequeue_position.load();
+    }
+
+    /**
+     * @brief Maximum number of queued tasks
+     *
+     * @returns Capacity of the ring buffer
+     */
+    std::size_t capacity() const {
+        return m_slots.size();
+    }
+
+private:
+    /**
+     * @brief Slot of the ring buffer which occupies whole cache lines
+     */
+    struct alignas(cache_line_size) Slot {
+        std::atomic<std::size_t> sequence;                                         ///< Round of the slot
+        typename std::aligned_storage<sizeof(Task), alignof(Task)>::type storage;  ///< Storage of the task
+    };
+
+    std::vector<Slot, CacheAlignedAllocator<Slot>> m_slots;                   ///< Ring buffer
+    const std::size_t m_mask;                                                 ///< Maps positions to slots
+    alignas(cache_line_size) std::atomic<std::size_t> m_enqueue_position{0};  ///< Next position to fill
+    alignas(cache_line_size) std::atomic<std::size_t> m_dequeue_position{0};  ///< Next position to drain
+
+    /**
+     * @brief Counts the consecutive slots which are free in the round of the given position
+     *
+     * @param position First position to check
+     * @param limit Maximum number of slots to count
+     *
+     * @returns Number of free slots starting at position
+     */
+    std::size_t countFreeSlots(std::size_t position, std::size_t limit) const {
+        std::size_t free_slots{0};
+        while (free_slots < limit && free_slots < m_slots.size() &&
+               m_slots[(position + free_slots) & m_mask].sequence.load(std::memory_order_acquire) ==
+               position + free_slots) {
+            ++free_slots;
+        }
+        return free_slots;
+    }
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t power_of_two{2};
+        while (power_of_two < value) {
+            power_of_two *= 2;
+        }
+        return power_of_two;
+    }
+};
+
+template<typename Task>
+constexpr std::size_t MpmcRingQueue<Task>::default_capacity;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_MPMC_RING_QUEUE_HPP_
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_MPSC_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Lock-free unbounded queue for many producers and a single consumer
+ *
+ * Implementation of the intrusive node based queue by Dmitry Vyukov. A push is a single atomic
+ * exchange followed by linking the node, so producers never wait for each other or for the
+ * consumer. Between the exchange and the link, the pushed item and all items which are pushed
+ * behind it are not yet visible to the consumer. The consumer has to retry a failed pop if it
+ * knows of pending items by other means.
+ *
+ * @tparam T Type of the stored items, must be default constructible and movable
+ */
+template<typename T>
+class MpscQueue {
+public:
+    /**
+     * @brief Constructor of an empty MpscQueue
+     */
+    MpscQueue() : m_head{new Node{}}, m_tail{m_head.load(std::memory_order_relaxed)} {}
+    MpscQueue(const MpscQueue&)            = delete;
+    MpscQueue(MpscQueue&&)                 = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue& operator=(MpscQueue&&)      = delete;
+
+    /**
+     * @brief Destructor, drops the items which were not popped
+     */
+    ~MpscQueue() {
+        while (m_tail != nullptr) {
+            auto* next{m_tail->next.load(std::memory_order_relaxed)};
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    /**
+     * @brief Pushes an item to the back of the queue
+     *
+     * This function can be called from any thread.
+     *
+     * @param item Item to push
+     */
+    void push(T&& item) {
+        auto* node{new Node{std::move(item)}};
+        auto* previous{m_head.exchange(node, std::memory_order_acq_rel)};
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pops the oldest item from the front of the queue
+     *
+     * @pre Must only be called by one thread at a time
+     *
+     * @param item Receives the popped item
+     *
+     * @returns True if an item was popped, false if the queue is empty or the next item is not linked yet
+     */
+    bool tryPop(T& item) {
+        auto* next{m_tail->next.load(std::memory_order_acquire)};
+        if (next == nullptr) {
+            return false;
+        }
+
+        // The popped node becomes the new stub, its item is moved out
+        item = std::move(next->item);
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+private:
+    /**
+     * @brief Node of the linked list, the node at the tail is a stub without item
+     */
+    struct Node {
+        Node() = default;
+        explicit Node(T&& value) : item{std::move(value)} {}
+
+        std::atomic<Node*> next{nullptr};  ///< Next younger node
+        T item{};                          ///< Stored item
+    };
+
+    std::atomic<Node*> m_head;  ///< Youngest node, exchanged by producers
+    Node* m_tail;               ///< Stub node in front of the oldest item, only accessed by the consumer
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_MPSC_QUEUE_HPP_
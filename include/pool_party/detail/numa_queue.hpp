@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_NUMA_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_NUMA_QUEUE_HPP_
+
+#include "cache_line.hpp"
+#include "numa_topology.hpp"
+#include "queue_tags.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Task queue with one fifo queue per NUMA node
+ *
+ * The workers are distributed round robin over the NUMA nodes, worker n belongs to node n modulo
+ * the number of nodes. Combined with pool_party::detail::NumaThreadFactory, each worker runs on a
+ * CPU of its node. Tasks are placed in the queue of the enqueuing worker's node, or of the node
+ * of the CPU the enqueuing thread currently runs on, unless a node is passed explicitly.
+ *
+ * Workers prefer tasks of their own node. Only when it has no tasks left, they take tasks from the
+ * other nodes, the nearest node first.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class NumaQueue {
+public:
+    using synchronization_tag = ConcurrentQueueTag;
+
+    /**
+     * @brief Constructor of NumaQueue
+     *
+     * @param number_of_workers Number of workers, they are distributed over the nodes
+     * @param nodes NUMA nodes, read from sysfs by default
+     */
+    explicit NumaQueue(std::size_t number_of_workers, const std::vector<NumaNode>& nodes = readNumaTopology()) :
+            m_number_of_workers{number_of_workers}, m_nodes(nodes.size()) {
+        for (std::size_t node_index{0}; node_index < nodes.size(); ++node_index) {
+            m_nodes[node_index].id = nodes[node_index].id;
+            m_nodes[node_index].steal_order = stealOrder(nodes, node_index);
+            for (const auto cpu : nodes[node_index].cpus) {
+                if (cpu >= m_cpu_nodes.size()) {
+                    m_cpu_nodes.resize(cpu + 1, 0);
+                }
+                m_cpu_nodes[cpu] = node_index;
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes a task to the queue of the callers node
+     *
+     * @param task Task which is moved into the queue
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Always true, the queue is unbounded
+     */
+    bool push(Task&& task, std::size_t worker_index) {
+        pushToNodeQueue(&task, &task + 1, m_nodes[localNodeIndex(worker_index)]);
+        return true;
+    }
+
+    /**
+     * @brief Pushes a range of tasks to the queue of the callers node
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Always last, the queue is unbounded
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t worker_index) {
+        return pushToNodeQueue(first, last, m_nodes[localNodeIndex(worker_index)]);
+    }
+
+    /**
+     * @brief Pushes a range of tasks to the queue of a specific node
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param node Id of the NUMA node
+     *
+     * @exception std::out_of_range is thrown when the node is unknown or has no usable CPUs
+     *
+     * @returns Always last, the queue is unbounded
+     */
+    template<typename Iterator>
+    Iterator pushToNode(Iterator first, Iterator last, std::size_t node) {
+        const auto node_queue{std::find_if(m_nodes.begin(), m_nodes.end(), [node](const NodeQueue& node_queue) {
+            return node_queue.id == node;
+        })};
+        if (node_queue == m_nodes.end()) {
+            throw std::out_of_range{"NUMA node is not available, enqueuing failed."};
+        }
+
+        return pushToNodeQueue(first, last, *node_queue);
+    }
+
+    /**
+     * @brief Takes a task from the queue
+     *
+     * Workers try their own node first, other threads the node they are running on. Afterwards
+     * the other nodes are tried in the order of their distance.
+     *
+     * @param task Receives the taken task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns True if a task was taken, false if no task was found
+     */
+    bool tryPop(Task& task, std::size_t worker_index) {
+        const auto node_index{localNodeIndex(worker_index)};
+        if (popFromNodeQueue(task, m_nodes[node_index])) {
+            return true;
+        }
+
+        for (const auto victim_index : m_nodes[node_index].steal_order) {
+            if (popFromNodeQueue(task, m_nodes[victim_index])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, may be outdated when other threads modify the queue
+     */
+    bool empty() const {
+        return std::all_of(m_nodes.begin(), m_nodes.end(), [](const NodeQueue& node_queue) {
+            return node_queue.count.load() == 0;
+        });
+    }
+
+    /**
+     * @brief Getter for the NUMA node of a worker
+     *
+     * @param worker_index Index of the worker
+     *
+     * @returns Id of the node the worker belongs to
+     */
+    std::size_t getNodeOfWorker(std::size_t worker_index) const {
+        return m_nodes[worker_index % m_nodes.size()].id;
+    }
+
+private:
+    /**
+     * @brief Tasks of a single node, on a separate cache line to avoid false sharing between nodes
+     */
+    struct alignas(cache_line_size) NodeQueue {
+        std::size_t id{0};                       ///< Id of the NUMA node
+        std::vector<std::size_t> steal_order{};  ///< Indices of the other nodes, the nearest first
+        std::mutex mtx{};                        ///< Guards the tasks
+        std::deque<Task> tasks{};                ///< Queued tasks, the oldest one is in front
+        std::atomic<std::size_t> count{0};       ///< Number of tasks, readable without lock
+    };
+
+    /// Queues of the nodes, aligned by hand since std::allocator ignores alignas before C++17
+    using NodeQueues = std::vector<NodeQueue, CacheAlignedAllocator<NodeQueue>>;
+
+    std::size_t m_number_of_workers;         ///< Number of workers, which are distributed over the nodes
+    NodeQueues m_nodes;                      ///< Queue of each node
+    std::vector<std::size_t> m_cpu_nodes{};  ///< Index of the node of each CPU
+
+    /**
+     * @brief Orders the other nodes by their distance to a node
+     */
+    static std::vector<std::size_t> stealOrder(const std::vector<NumaNode>& nodes, std::size_t node_index) {
+        const auto& distances{nodes[node_index].distances};
+        auto distance{[&distances, &nodes](std::size_t other_index) {
+            const auto other_id{nodes[other_index].id};
+            return other_id < distances.size() ? distances[other_id] : 0;
+        }};
+
+        std::vector<std::size_t> steal_order{};
+        for (std::size_t other_index{0}; other_index < nodes.size(); ++other_index) {
+            if (other_index != node_index) {
+                steal_order.push_back(other_index);
+            }
+        }
+        std::stable_sort(steal_order.begin(), steal_order.end(), [&distance](std::size_t lhs, std::size_t rhs) {
+            return distance(lhs) < distance(rhs);
+        });
+        return steal_order;
+    }
+
+    /**
+     * @brief Determines the node of the calling thread
+     *
+     * Workers belong to a fixed node, other threads to the node of the CPU they are running on.
+     */
+    std::size_t localNodeIndex(std::size_t worker_index) const {
+        if (worker_index < m_number_of_workers) {
+            return worker_index % m_nodes.size();
+        }
+#if defined(__linux__)
+        const auto cpu{sched_getcpu()};
+        if (cpu >= 0 && static_cast<std::size_t>(cpu) < m_cpu_nodes.size()) {
+            return m_cpu_nodes[static_cast<std::size_t>(cpu)];
+        }
+#endif
+        return 0;
+    }
+
+    template<typename Iterator>
+    static Iterator pushToNodeQueue(Iterator first, Iterator last, NodeQueue& node_queue) {
+        std::lock_guard<std::mutex> lg{node_queue.mtx};
+        node_queue.tasks.insert(node_queue.tasks.end(), std::make_move_iterator(first), std::make_move_iterator(last));
+        node_queue.count.store(node_queue.tasks.size());
+        return last;
+    }
+
+    static bool popFromNodeQueue(Task& task, NodeQueue& node_queue) {
+        if (node_queue.count.load() == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lg{node_queue.mtx};
+        if (node_queue.tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(node_queue.tasks.front());
+        node_queue.tasks.pop_front();
+        node_queue.count.store(node_queue.tasks.size());
+        return true;
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_NUMA_QUEUE_HPP_
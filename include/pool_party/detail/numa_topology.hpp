@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_NUMA_TOPOLOGY_HPP_
+#define POOL_PARTY_DETAIL_NUMA_TOPOLOGY_HPP_
+
+#include "cpu_topology.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief NUMA node with the CPUs which are attached to it
+ */
+struct NumaNode {
+    std::size_t id;                      ///< Index of the node as used by the operating system
+    std::vector<std::size_t> cpus;       ///< Usable CPUs of the node in ascending order
+    std::vector<std::size_t> distances;  ///< Relative access costs to all online nodes, indexed by node id
+};
+
+/**
+ * @brief Parses a list in the sysfs list format, e.g. "0-3,8,10-11"
+ *
+ * @param list Text of the list
+ *
+ * @returns Ascending numbers of the list
+ */
+inline std::vector<std::size_t> parseSysfsList(const std::string& list) {
+    std::vector<std::size_t> numbers{};
+    std::istringstream list_stream{list};
+    std::string range{};
+    while (std::getline(list_stream, range, ',')) {
+        std::istringstream range_stream{range};
+        std::size_t first{0};
+        if (!(range_stream >> first)) {
+            continue;
+        }
+
+        std::size_t last{first};
+        char separator{};
+        if (range_stream >> separator && separator == '-') {
+            range_stream >> last;
+        }
+        for (auto number{first}; number <= last; ++number) {
+            numbers.push_back(number);
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+/**
+ * @brief Reads the first line of a sysfs file
+ *
+ * @param path Path of the file
+ *
+ * @returns First line of the file, empty if the file can't be read
+ */
+inline std::string readSysfsLine(const std::string& path) {
+    std::ifstream file{path};
+    std::string line{};
+    std::getline(file, line);
+    return line;
+}
+
+/**
+ * @brief Reads the NUMA nodes from sysfs
+ *
+ * Only CPUs the process may run on are listed and nodes without such CPUs, e.g. memory only
+ * nodes, are skipped. Machines without NUMA information are described by a single node which
+ * contains all usable CPUs.
+ *
+ * @param cpus Usable CPUs, the affinity mask of the process by default
+ * @param sysfs_node_path Directory which contains the nodeN directories
+ *
+ * @returns NUMA nodes in ascending id order
+ */
+inline std::vector<NumaNode> readNumaTopology(const std::vector<std::size_t>& cpus = availableCpus(),
+                                              const std::string& sysfs_node_path = "/sys/devices/system/node") {
+    std::vector<NumaNode> nodes{};
+    for (const auto node_id : parseSysfsList(readSysfsLine(sysfs_node_path + "/online"))) {
+        const auto node_path{sysfs_node_path + "/node" + std::to_string(node_id)};
+
+        NumaNode node{node_id, {}, {}};
+        for (const auto cpu : parseSysfsList(readSysfsLine(node_path + "/cpulist"))) {
+            if (std::binary_search(cpus.begin(), cpus.end(), cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        std::istringstream distances{readSysfsLine(node_path + "/distance")};
+        std::size_t distance{0};
+        while (distances >> distance) {
+            node.distances.push_back(distance);
+        }
+
+        if (!node.cpus.empty()) {
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.push_back(NumaNode{0, cpus, {}});
+    }
+    return nodes;
+}
+
+/**
+ * @brief Lists CPUs so that the n-th thread runs on NUMA node n modulo the number of nodes
+ *
+ * Used round robin, the list spreads the threads of each node over its CPUs.
+ *
+ * @param nodes NUMA nodes
+ *
+ * @returns CPU list for pool_party::detail::PinnedThreadFactory
+ */
+inline std::vector<std::size_t> numaWorkerCpus(const std::vector<NumaNode>& nodes) {
+    std::size_t max_cpus_per_node{0};
+    for (const auto& node : nodes) {
+        max_cpus_per_node = std::max(max_cpus_per_node, node.cpus.size());
+    }
+
+    std::vector<std::size_t> cpus{};
+    cpus.reserve(max_cpus_per_node * nodes.size());
+    for (std::size_t round{0}; round < max_cpus_per_node; ++round) {
+        for (const auto& node : nodes) {
+            cpus.push_back(node.cpus[round % node.cpus.size()]);
+        }
+    }
+    return cpus;
+}
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_NUMA_TOPOLOGY_HPP_
@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_PARALLEL_LOOP_HPP_
+#define POOL_PARTY_DETAIL_PARALLEL_LOOP_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace pool_party {
+
+/**
+ * @brief Strategies to split the iteration space of parallel algorithms into chunks
+ */
+enum class Chunking {
+    static_size,  ///< Equal chunks, one per participating thread, for uniform work per element
+    guided,       ///< Chunks shrink with the remaining work, balances moderately irregular work
+    adaptive      ///< Chunk sizes follow the measured cost per element, for unknown or irregular work
+};
+
+namespace detail {
+
+/**
+ * @brief Iteration space of a parallel loop which is shared by all participating threads
+ *
+ * Threads claim chunks of indices until the space is exhausted. Completed chunks are counted, so
+ * the calling thread knows when the last chunk has finished without waiting for helper tasks
+ * which didn't start yet. This allows parallel loops within tasks of the same pool.
+ *
+ * @tparam ChunkFunction Callable type which is called with the begin and end index of a chunk
+ */
+template<typename ChunkFunction>
+class ParallelLoop {
+public:
+    static constexpr std::chrono::microseconds adaptive_chunk_duration{50};  ///< Targeted duration of adaptive chunks
+
+    /**
+     * @brief Constructor of ParallelLoop
+     *
+     * @param size Number of indices
+     * @param participants Number of threads which may work on the loop
+     * @param chunking Strategy which determines the chunk sizes
+     * @param grain_size Minimum number of indices per chunk
+     * @param chunk_function Callable which processes a chunk
+     */
+    ParallelLoop(std::size_t size,
+                 std::size_t participants,
+                 Chunking chunking,
+                 std::size_t grain_size,
+                 ChunkFunction chunk_function) :
+            m_size{size},
+            m_participants{std::max<std::size_t>(participants, 1)},
+            m_chunking{chunking},
+            m_grain_size{std::max<std::size_t>(grain_size, 1)},
+            m_chunk_function(std::move(chunk_function)) {}
+
+    /**
+     * @brief Processes chunks until all indices are claimed
+     *
+     * An exception of the chunk function is stored and the remaining chunks are skipped.
+     */
+    void participate() {
+        std::size_t chunk_size{m_grain_size};
+        std::size_t begin{0};
+        while (claim(begin, chunk_size)) {
+            const auto end{begin + chunk_size};
+            if (!m_failed.load(std::memory_order_relaxed)) {
+                const auto start_time{std::chrono::steady_clock::now()};
+                try {
+                    m_chunk_function(begin, end);
+                } catch (...) {
+                    storeException(std::current_exception());
+                }
+                chunk_size = nextAdaptiveChunkSize(chunk_size, std::chrono::steady_clock::now() - start_time);
+            }
+            complete(end - begin);
+        }
+    }
+
+    /**
+     * @brief Blocks until all chunks are completed
+     *
+     * @exception Rethrows the first exception of the chunk function
+     */
+    void wait() {
+        std::unique_lock<std::mutex> ul{m_mtx};
+        m_cv.wait(ul, [this]() { return m_completed == m_size; });
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    const std::size_t m_size;                 ///< Number of indices
+    const std::size_t m_participants;         ///< Number of threads which may work on the loop
+    const Chunking m_chunking;                ///< Strategy which determines the chunk sizes
+    const std::size_t m_grain_size;           ///< Minimum number of indices per chunk
+    ChunkFunction m_chunk_function;           ///< Processes a chunk
+    std::atomic<std::size_t> m_next{0};       ///< First index which is not claimed yet
+    std::atomic<bool> m_failed{false};        ///< Set when the chunk function has thrown
+    std::mutex m_mtx{};                       ///< Guards the completion state
+    std::condition_variable m_cv{};           ///< Signals the completion of the last chunk
+    std::size_t m_completed{0};               ///< Number of processed or skipped indices
+    std::exception_ptr m_exception{};         ///< First exception of the chunk function
+
+    /**
+     * @brief Claims the next chunk
+     *
+     * @param begin Receives the first index of the chunk
+     * @param chunk_size Desired size of adaptive chunks, receives the size of the claimed chunk
+     *
+     * @returns True if a chunk was claimed, false if all indices are claimed
+     */
+    bool claim(std::size_t& begin, std::size_t& chunk_size) {
+        const auto desired_chunk_size{chunk_size};
+        begin = m_next.load(std::memory_order_relaxed);
+        do {
+            if (begin >= m_size) {
+                return false;
+            }
+            chunk_size = std::min(chunkSize(begin, desired_chunk_size), m_size - begin);
+        } while (!m_next.compare_exchange_weak(begin, begin + chunk_size, std::memory_order_relaxed));
+        return true;
+    }
+
+    std::size_t chunkSize(std::size_t begin, std::size_t desired_chunk_size) const {
+        const auto remaining{m_size - begin};
+        switch (m_chunking) {
+        case Chunking::static_size:
+            return std::max((m_size + m_participants - 1) / m_participants, m_grain_size);
+        case Chunking::guided:
+            return std::max(remaining / (2 * m_participants), m_grain_size);
+        case Chunking::adaptive:
+            // Never take more than a fair share of the remaining work, otherwise balance suffers
+            return std::max(std::min(desired_chunk_size, remaining / m_participants), m_grain_size);
+        }
+        return m_grain_size;
+    }
+
+    /**
+     * @brief Scales adaptive chunks so that they take about adaptive_chunk_duration
+     */
+    std::size_t nextAdaptiveChunkSize(std::size_t chunk_size, std::chrono::steady_clock::duration elapsed) const {
+        if (m_chunking != Chunking::adaptive) {
+            return chunk_size;
+        }
+
+        const auto elapsed_ns{std::max<std::chrono::nanoseconds::rep>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1)};
+        const auto target_ns{std::chrono::duration_cast<std::chrono::nanoseconds>(adaptive_chunk_duration).count()};
+        const auto scaled_size{static_cast<double>(chunk_size) * static_cast<double>(target_ns) /
+                               static_cast<double>(elapsed_ns)};
+
+        // Grow at most by factor two per chunk, so a single fast chunk doesn't claim everything
+        return std::max(std::min(static_cast<std::size_t>(scaled_size), 2 * chunk_size), m_grain_size);
+    }
+
+    void storeException(std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lg{m_mtx};
+        if (!m_exception) {
+            m_exception = std::move(exception);
+        }
+        m_failed.store(true, std::memory_order_relaxed);
+    }
+
+    void complete(std::size_t number_of_indices) {
+        std::lock_guard<std::mutex> lg{m_mtx};
+        m_completed += number_of_indices;
+        if (m_completed == m_size) {
+            m_cv.notify_all();
+        }
+    }
+};
+
+template<typename ChunkFunction>
+constexpr std::chrono::microseconds ParallelLoop<ChunkFunction>::adaptive_chunk_duration;
+
+/**
+ * @brief Runs a parallel loop on a thread pool and the calling thread
+ *
+ * Helper tasks are posted to the pool, the calling thread processes chunks as well and returns
+ * when all chunks are completed. Helper tasks which start later find no work and return
+ * immediately.
+ *
+ * @tparam Pool Thread pool type which provides post and getNumberOfThreads
+ * @tparam ChunkFunction Callable type which is called with the begin and end index of a chunk
+ *
+ * @param pool Thread pool which runs the helper tasks
+ * @param size Number of indices
+ * @param chunking Strategy which determines the chunk sizes
+ * @param grain_size Minimum number of indices per chunk
+ * @param chunk_function Callable which processes a chunk
+ *
+ * @exception Rethrows the first exception of the chunk function
+ * @exception std::runtime_error is thrown when the thread pool is already shut down
+ */
+template<typename Pool, typename ChunkFunction>
+void runParallelLoop(Pool& pool,
+                     std::size_t size,
+                     Chunking chunking,
+                     std::size_t grain_size,
+                     ChunkFunction chunk_function) {
+    if (size == 0) {
+        return;
+    }
+
+    grain_size = std::max<std::size_t>(grain_size, 1);
+    const auto participants{pool.getNumberOfThreads() + 1};
+    const auto number_of_chunks{(size + grain_size - 1) / grain_size};
+    const auto loop{
+    std::make_shared<ParallelLoop<ChunkFunction>>(size, participants, chunking, grain_size, std::move(chunk_function))};
+
+    // The chunk function may reference the caller's stack, so the loop has to finish before any exception leaves
+    std::exception_ptr post_exception{};
+    try {
+        const auto helpers{std::min(participants - 1, number_of_chunks - 1)};
+        for (std::size_t helper{0}; helper < helpers; ++helper) {
+            pool.post([loop]() { loop->participate(); });
+        }
+    } catch (...) {
+        post_exception = std::current_exception();
+    }
+
+    loop->participate();
+    loop->wait();
+    if (post_exception) {
+        std::rethrow_exception(post_exception);
+    }
+}
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_PARALLEL_LOOP_HPP_
@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_PINNED_THREAD_FACTORY_HPP_
+#define POOL_PARTY_DETAIL_PINNED_THREAD_FACTORY_HPP_
+
+#include "cpu_topology.hpp"
+#include "numa_topology.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Placement strategies for pinned threads
+ */
+enum class CpuPlacement {
+    compact,  ///< Fill the hyper threads of a core and the cores of a package first, threads share caches
+    scatter   ///< Spread threads over packages and cores first, threads share as few resources as possible
+};
+
+/**
+ * @brief Sets the CPU affinity of threads with the native thread API
+ */
+struct ThreadAffinity {
+    /**
+     * @brief Pins the calling thread to a single CPU
+     *
+     * @param cpu Index of the CPU
+     *
+     * @returns True if the thread was pinned, false if the platform doesn't support pinning or
+     *          the CPU is not available
+     */
+    static bool pinCurrentThread(std::size_t cpu) {
+#if defined(__linux__)
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+
+        cpu_set_t cpu_set{};
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+        static_cast<void>(cpu);
+        return false;
+#endif
+    }
+};
+
+/**
+ * @brief Factory to fabricate threads which are pinned to CPUs
+ *
+ * Threads are assigned round robin to a list of CPUs. Each thread pins itself before it calls
+ * its thread function, so it never migrates between CPUs and keeps its caches warm. When pinning
+ * fails, e.g. because the CPU is not available, the thread runs unpinned.
+ *
+ * @tparam ThreadType The thread type to fabricate
+ * @tparam Affinity Type with a static pinCurrentThread(std::size_t) function which pins the
+ *                  calling thread
+ */
+template<typename ThreadType, typename Affinity = ThreadAffinity>
+class PinnedThreadFactory {
+public:
+    using thread_type = ThreadType;
+
+    /**
+     * @brief Constructor of PinnedThreadFactory which uses all available CPUs in compact order
+     */
+    PinnedThreadFactory() : PinnedThreadFactory{CpuPlacement::compact} {}
+
+    /**
+     * @brief Constructor of PinnedThreadFactory which orders CPUs by a placement strategy
+     *
+     * @param placement Placement strategy
+     * @param topology CPUs which are used for pinning, the available CPUs of the process by default
+     */
+    explicit PinnedThreadFactory(CpuPlacement placement, const std::vector<CpuInfo>& topology = readCpuTopology()) :
+            m_cpus{placement == CpuPlacement::compact ? compactCpuOrder(topology) : scatterCpuOrder(topology)} {}
+
+    /**
+     * @brief Constructor of PinnedThreadFactory with an explicit CPU list
+     *
+     * The n-th created thread is pinned to the n-th CPU of the list. When there are more threads
+     * than CPUs, the list is used round robin.
+     *
+     * @param cpus Indices of the CPUs, an empty list disables pinning
+     */
+    explicit PinnedThreadFactory(std::vector<std::size_t> cpus) : m_cpus{std::move(cpus)} {}
+
+    /**
+     * @brief Creates a thread of type ThreadType which pins itself to the next CPU
+     *
+     * @param thread_function The callable function which is passed to the thread.
+     */
+    template<typename Callable, typename... Args>
+    ThreadType create(Callable&& thread_function, Args&&... args) {
+        using FunctionType = typename std::decay<Callable>::type;
+        PinnedFunction<FunctionType> pinned_function{nextCpu(), FunctionType{std::forward<Callable>(thread_function)}};
+        return ThreadType{std::move(pinned_function), std::forward<Args>(args)...};
+    }
+
+    /**
+     * @brief Creates the thread of a pool worker which pins itself to the CPU of its worker index
+     *
+     * The worker with index n is pinned to the n-th CPU of the list, independent of how many
+     * threads the factory created before. A worker which is created again keeps its CPU.
+     *
+     * @param worker_index Index of the worker within its pool
+     * @param thread_function The callable function which is passed to the thread.
+     */
+    template<typename Callable>
+    ThreadType createWorker(std::size_t worker_index, Callable&& thread_function) {
+        using FunctionType = typename std::decay<Callable>::type;
+        PinnedFunction<FunctionType> pinned_function{cpuAt(worker_index),
+                                                     FunctionType{std::forward<Callable>(thread_function)}};
+        return ThreadType{std::move(pinned_function)};
+    }
+
+    /**
+     * @brief Getter for the CPUs threads are pinned to
+     *
+     * @returns CPU indices in the order they are assigned to threads
+     */
+    const std::vector<std::size_t>& getCpus() const {
+        return m_cpus;
+    }
+
+private:
+    static constexpr std::size_t no_cpu{std::numeric_limits<std::size_t>::max()};  ///< Thread is not pinned
+
+    /**
+     * @brief Thread function which pins the thread before it calls the actual function
+     */
+    template<typename Function>
+    struct PinnedFunction {
+        std::size_t cpu;    ///< CPU the thread is pinned to
+        Function function;  ///< Actual thread function
+
+        template<typename... Args>
+        void operator()(Args&&... args) {
+            if (cpu != no_cpu) {
+                Affinity::pinCurrentThread(cpu);
+            }
+            function(std::forward<Args>(args)...);
+        }
+    };
+
+    std::vector<std::size_t> m_cpus{};  ///< CPUs in the order they are assigned to threads
+    std::size_t m_created_threads{0};   ///< Number of created threads
+
+    std::size_t nextCpu() {
+        return cpuAt(m_created_threads++);
+    }
+
+    std::size_t cpuAt(std::size_t index) const {
+        if (m_cpus.empty()) {
+            return no_cpu;
+        }
+        return m_cpus[index % m_cpus.size()];
+    }
+};
+
+template<typename ThreadType, typename Affinity>
+constexpr std::size_t PinnedThreadFactory<ThreadType, Affinity>::no_cpu;
+
+/**
+ * @brief Factory to fabricate threads which are pinned to the CPUs of NUMA nodes
+ *
+ * The worker with index n runs on NUMA node n modulo the number of nodes, which matches the
+ * distribution of workers in pool_party::detail::NumaQueue.
+ *
+ * @tparam ThreadType The thread type to fabricate
+ * @tparam Affinity Type with a static pinCurrentThread(std::size_t) function which pins the
+ *                  calling thread
+ */
+template<typename ThreadType, typename Affinity = ThreadAffinity>
+class NumaThreadFactory : public PinnedThreadFactory<ThreadType, Affinity> {
+public:
+    /**
+     * @brief Constructor of NumaThreadFactory
+     *
+     * @param nodes NUMA nodes, read from sysfs by default
+     */
+    explicit NumaThreadFactory(const std::vector<NumaNode>& nodes = readNumaTopology()) :
+            PinnedThreadFactory<ThreadType, Affinity>{numaWorkerCpus(nodes)} {}
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_PINNED_THREAD_FACTORY_HPP_
@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_PRIORITY_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_PRIORITY_QUEUE_HPP_
+
+#include "queue_tags.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Priority levels of tasks
+ */
+enum class Priority : std::uint8_t {
+    low,      ///< Background work, e.g. bulk jobs
+    normal,   ///< Default priority of enqueued tasks
+    high,     ///< Work which should overtake normal tasks
+    critical  ///< Latency critical work
+};
+
+/**
+ * @brief Task queue with a fifo queue per priority level
+ *
+ * Workers take the oldest task of the highest non-empty priority level. Pushing and popping
+ * only look at the small fixed number of levels, so both are O(1).
+ *
+ * To prevent starvation, tasks age with every task which is taken from the queue. A task
+ * which waited for more than the aging threshold is taken next, regardless of its priority.
+ * Workers take the tasks one by one, a popped batch would delay tasks which are pushed later.
+ *
+ * Like pool_party::detail::FifoQueue, the queue is not thread safe. The thread pool guards
+ * every access with the mutex of its sync object.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class PriorityQueue {
+public:
+    using synchronization_tag = LockedQueueTag;
+
+    static constexpr std::size_t number_of_priorities{4};         ///< Number of priority levels
+    static constexpr std::size_t default_aging_threshold{1024};  ///< Aging threshold when none is passed
+    static constexpr std::size_t max_pop_batch{1};               ///< Popped batches would delay later urgent tasks
+
+    /**
+     * @brief Constructor of PriorityQueue
+     *
+     * @param number_of_workers Unused, all workers share the same queue
+     * @param aging_threshold Number of tasks which may overtake a task before it is taken next
+     */
+    explicit PriorityQueue(std::size_t /*number_of_workers*/, std::size_t aging_threshold = default_aging_threshold) :
+            m_aging_threshold{aging_threshold} {}
+
+    /**
+     * @brief Appends a task with normal priority
+     *
+     * @param task Task which is moved into the queue
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns Always true, the queue is unbounded
+     */
+    bool push(Task&& task, std::size_t worker_index) {
+        push(&task, &task + 1, worker_index, Priority::normal);
+        return true;
+    }
+
+    /**
+     * @brief Appends a range of tasks with normal priority
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns Always last, the queue is unbounded
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t worker_index) {
+        return push(first, last, worker_index, Priority::normal);
+    }
+
+    /**
+     * @brief Appends a range of tasks to the level of a priority
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     * @param priority Priority of the tasks
+     *
+     * @returns Always last, the queue is unbounded
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t /*worker_index*/, Priority priority) {
+        auto& level{m_levels[static_cast<std::size_t>(priority)]};
+        for (; first != last; ++first) {
+            level.push_back(Entry{std::move(*first), m_popped_tasks});
+            ++m_size;
+        }
+        return last;
+    }
+
+    /**
+     * @brief Removes the next task from the queue
+     *
+     * This is the oldest task of the highest non-empty level, unless a task of a lower level
+     * exceeded the aging threshold.
+     *
+     * @param task Receives the next task when the queue is not empty
+     * @param worker_index Unused, tasks of workers and other threads are treated equally
+     *
+     * @returns True if a task was removed, false if the queue is empty
+     */
+    bool tryPop(Task& task, std::size_t /*worker_index*/) {
+        if (m_size == 0) {
+            return false;
+        }
+
+        auto& level{m_levels[nextLevel()]};
+        task = std::move(level.front().task);
+        level.pop_front();
+        --m_size;
+        ++m_popped_tasks;
+        return true;
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, false otherwise
+     */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Number of queued tasks
+     *
+     * @returns Number of tasks of all levels
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+private:
+    /**
+     * @brief Queued task with the point in time it was pushed
+     */
+    struct Entry {
+        Task task;              ///< Queued task
+        std::size_t pushed_at;  ///< Number of popped tasks when the task was pushed
+    };
+
+    std::array<std::deque<Entry>, number_of_priorities> m_levels{};  ///< Fifo queue of each level, lowest first
+    std::size_t m_aging_threshold;                                   ///< Tasks which may overtake a task
+    std::size_t m_popped_tasks{0};                                   ///< Number of popped tasks, the age clock
+    std::size_t m_size{0};                                           ///< Number of tasks of all levels
+
+    /**
+     * @brief Selects the level of the next task
+     *
+     * @pre The queue must not be empty
+     *
+     * @returns Index of the level whose oldest task exceeded the aging threshold the most, the
+     *          highest non-empty level if no task is starving
+     */
+    std::size_t nextLevel() const {
+        std::size_t highest_level{0};
+        std::size_t starving_level{number_of_priorities};
+        std::size_t max_age{m_aging_threshold};
+        for (std::size_t level{0}; level < number_of_priorities; ++level) {
+            if (m_levels[level].empty()) {
+                continue;
+            }
+
+            highest_level = level;
+            const auto age{m_popped_tasks - m_levels[level].front().pushed_at};
+            if (age > max_age) {
+                max_age        = age;
+                starving_level = level;
+            }
+        }
+        return starving_level != number_of_priorities ? starving_level : highest_level;
+    }
+};
+
+template<typename Task>
+constexpr std::size_t PriorityQueue<Task>::number_of_priorities;
+
+template<typename Task>
+constexpr std::size_t PriorityQueue<Task>::default_aging_threshold;
+
+template<typename Task>
+constexpr std::size_t PriorityQueue<Task>::max_pop_batch;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_PRIORITY_QUEUE_HPP_
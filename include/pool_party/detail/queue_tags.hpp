@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_QUEUE_TAGS_HPP_
+#define POOL_PARTY_DETAIL_QUEUE_TAGS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Tag for task queues which are protected by the mutex of the thread pools sync object
+ *
+ * The thread pool accesses queues with this tag exclusively inside of a critical section. Besides
+ * push, tryPop and empty, these queues provide size(), so workers can pop a share of the queued
+ * tasks at once. Queues which don't serve their tasks in arrival order can limit that share with
+ * a static max_pop_batch member, see pool_party::detail::MaxPopBatch.
+ */
+struct LockedQueueTag {};
+
+/**
+ * @brief Tag for task queues which synchronize themselves
+ *
+ * The thread pool pushes and pops tasks of queues with this tag without holding the mutex of
+ * the sync object. The sync object is only used to park idle worker threads.
+ */
+struct ConcurrentQueueTag {};
+
+/**
+ * @brief Upper limit of tasks which a worker pops at once from a locked queue
+ *
+ * Popped tasks are executed in the order of the batch, so a task which is pushed afterwards
+ * waits behind the whole batch, whatever its priority. Queues without max_pop_batch member
+ * don't limit the batch.
+ *
+ * @tparam Queue Type of the task queue
+ */
+template<typename Queue, typename = void>
+struct MaxPopBatch : std::integral_constant<std::size_t, std::numeric_limits<std::size_t>::max()> {};
+
+template<typename Queue>
+struct MaxPopBatch<Queue, decltype(void(Queue::max_pop_batch))>
+        : std::integral_constant<std::size_t, Queue::max_pop_batch> {};
+
+/**
+ * @brief Time until a worker may take one of the tasks of a locked queue with reservations
+ *
+ * Preferred overload of reservedFor for queues with a reservedFor(std::size_t) member.
+ */
+template<typename Queue>
+auto reservedFor(const Queue& queue, std::size_t worker_index, int) -> decltype(queue.reservedFor(worker_index)) {
+    return queue.reservedFor(worker_index);
+}
+
+/**
+ * @brief Time until a worker may take one of the tasks of a queue without reservations
+ */
+template<typename Queue>
+std::chrono::steady_clock::duration reservedFor(const Queue&, std::size_t, long) {
+    return std::chrono::steady_clock::duration::zero();
+}
+
+/**
+ * @brief Time until a worker may take one of the tasks of a locked queue
+ *
+ * Queues can reserve a task for a single worker for a short time, like the slots of
+ * pool_party::detail::LifoSlotQueue. Such queues provide a reservedFor(std::size_t) member, so
+ * idle workers park instead of spinning while only reserved tasks are queued. Other queues never
+ * reserve tasks.
+ *
+ * @param queue Task queue, the caller must hold the mutex which guards it
+ * @param worker_index Index of the calling worker
+ *
+ * @returns Zero if the worker can take a task or no task is queued, the time until a reserved
+ *          task becomes available to the worker otherwise
+ */
+template<typename Queue>
+std::chrono::steady_clock::duration reservedFor(const Queue& queue, std::size_t worker_index) {
+    return reservedFor(queue, worker_index, 0);
+}
+
+/**
+ * @brief Capacity of a queue which may be bounded
+ *
+ * Preferred overload of queueCapacity for queues with a capacity() member.
+ */
+template<typename Queue>
+auto queueCapacity(const Queue& queue, int) -> decltype(std::size_t{queue.capacity()}) {
+    return queue.capacity();
+}
+
+/**
+ * @brief Capacity of a queue which is always unbounded
+ */
+template<typename Queue>
+std::size_t queueCapacity(const Queue&, long) {
+    return std::numeric_limits<std::size_t>::max();
+}
+
+/**
+ * @brief Maximum number of tasks a queue takes
+ *
+ * Only queues with a capacity() member can be bounded. The thread pool applies backpressure to
+ * producers of bounded queues only.
+ *
+ * @param queue Task queue
+ *
+ * @returns Capacity of the queue, std::numeric_limits<std::size_t>::max() if it is unbounded
+ */
+template<typename Queue>
+std::size_t queueCapacity(const Queue& queue) {
+    return queueCapacity(queue, 0);
+}
+
+/**
+ * @brief Worker index which is passed to task queues when the caller is not a worker thread
+ */
+constexpr std::size_t no_worker_index{std::numeric_limits<std::size_t>::max()};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_QUEUE_TAGS_HPP_
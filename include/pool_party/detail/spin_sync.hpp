@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_SPIN_SYNC_HPP_
+#define POOL_PARTY_DETAIL_SPIN_SYNC_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Hints the processor that the calling thread is busy waiting
+ *
+ * Uses the pause instruction on x86 and yield on ARM, which saves power and frees resources of the
+ * sibling hyper thread. Other architectures give up the time slice instead.
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Class to synchronize pool threads which spins before it parks waiting threads
+ *
+ * Drop-in replacement for pool_party::detail::Sync. A waiting thread doesn't block on the
+ * condition variable right away but busy waits for a notification first. Tasks which arrive
+ * within the spin budget are picked up without the latency of a kernel wakeup. When the budget
+ * is exhausted, the thread parks on the condition variable like with Sync.
+ *
+ * Spinning threads watch a notification counter instead of the mutex, so they don't slow down
+ * producers and other workers.
+ *
+ * @tparam MutexType Mutex type which is used for synchronization
+ * @tparam ConditionVariableType CV type which is used for synced waiting
+ */
+template<typename MutexType, typename ConditionVariableType>
+class SpinSync {
+public:
+    using mutex_type = MutexType;
+
+    static constexpr std::size_t default_spin_budget{4096};  ///< Spin iterations when none are passed
+    static constexpr std::size_t pause_spins{64};            ///< Spin iterations before yielding the processor
+
+    /**
+     * @brief Constructor of SpinSync
+     *
+     * @param spin_budget Maximum number of spin iterations before a waiting thread parks, zero
+     *                    parks right away like Sync
+     */
+    explicit SpinSync(std::size_t spin_budget = default_spin_budget) : m_spin_budget{spin_budget} {}
+
+    /**
+     * @brief Blocking waitThenExecute until sync object is notified
+     *
+     * This function can be called from multiple threads which all block until the predicate is
+     * true. A thread re-checks the predicate whenever a notification arrives while it spins.
+     *
+     * @tparam Predicate Callable type for checking function
+     *
+     * @param predicate Callable which is checked to be true when sync woke up
+     * @param locked_func Callable which is called in a synchronized scope
+     *                    This callable takes a std::unique_lock& as parameter which is can be
+     *                    used to stop the critical section within the callable.
+     */
+    template<typename Predicate, typename Callable>
+    void waitThenExecute(Predicate &&predicate, Callable &&locked_func) {
+        std::unique_lock<MutexType> ul{m_mtx};
+        spinThenPark(ul, predicate, [this, &predicate](std::unique_lock<MutexType> &lock) {
+            m_cv.wait(lock, predicate);
+            return true;
+        });
+        locked_func(ul);
+    }
+
+    /**
+     * @brief Blocking waitThenExecute with a timeout
+     *
+     * Works like waitThenExecute, but gives up when the predicate is still false after the
+     * timeout. The spinning phase counts towards the timeout.
+     *
+     * @tparam Predicate Callable type for checking function
+     *
+     * @param timeout Maximum duration to wait for the predicate
+     * @param predicate Callable which is checked to be true when sync woke up
+     * @param locked_func Callable which is called in a synchronized scope, only if the predicate
+     *                    became true
+     *
+     * @returns True if the predicate became true and locked_func was called, false on timeout
+     */
+    template<typename Rep, typename Period, typename Predicate, typename Callable>
+    bool waitForThenExecute(const std::chrono::duration<Rep, Period> &timeout,
+                            Predicate &&predicate,
+                            Callable &&locked_func) {
+        const auto deadline{std::chrono::steady_clock::now() + timeout};
+        std::unique_lock<MutexType> ul{m_mtx};
+        if (!spinThenPark(ul, predicate, [this, &predicate, &deadline](std::unique_lock<MutexType> &lock) {
+                return m_cv.wait_until(lock, deadline, predicate);
+            })) {
+            return false;
+        }
+        locked_func(ul);
+        return true;
+    }
+
+    /**
+     * @brief Notifies one waiting thread
+     *
+     * Spinning threads always see the notification, the condition variable is only signaled
+     * when a thread is parked.
+     */
+    void notifyOne() {
+        m_notifications.fetch_add(1);
+        if (m_parked_threads.load() != 0) {
+            m_cv.notify_one();
+        }
+    }
+
+    /**
+     * @brief Notifies all waiting threads
+     *
+     * Spinning threads always see the notification, the condition variable is only signaled
+     * when a thread is parked.
+     */
+    void notifyAll() {
+        m_notifications.fetch_add(1);
+        if (m_parked_threads.load() != 0) {
+            m_cv.notify_all();
+        }
+    }
+
+    /**
+     * @brief Getter for the number of threads which are parked on the condition variable
+     *
+     * @returns Number of parked threads, spinning threads are not counted
+     */
+    std::size_t getParkedThreads() const {
+        return m_parked_threads.load();
+    }
+
+    /**
+     * @details Executes a callable guarded by mutex used for synchronization
+     *
+     * @tparam Callable Type of callable which gets executed
+     *
+     * @param function_to_call Function is going to be called in a critical section
+     */
+    template<typename Callable>
+    void executeLocked(Callable &&function_to_call) {
+        std::lock_guard<MutexType> lg{m_mtx};
+        function_to_call();
+    }
+
+    /**
+     * @brief Changes the number of spin iterations before a waiting thread parks
+     *
+     * Threads which are already waiting keep their current budget.
+     *
+     * @param spin_budget Maximum number of spin iterations, zero disables spinning
+     */
+    void setSpinBudget(std::size_t spin_budget) {
+        m_spin_budget.store(spin_budget, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Getter for the number of spin iterations before a waiting thread parks
+     *
+     * @returns Spin budget
+     */
+    std::size_t getSpinBudget() const {
+        return m_spin_budget.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Getter for internally used mutex reference
+     *
+     * @returns Mutex reference
+     */
+    MutexType &getMutex() {
+        return m_mtx;
+    }
+
+    /**
+     * @brief Getter for internally used condition variable reference
+     *
+     * @returns Condition variable reference
+     */
+    ConditionVariableType &getConditionVariable() {
+        return m_cv;
+    }
+
+private:
+    MutexType m_mtx{};                             ///< Internal mutex
+    ConditionVariableType m_cv{};                  ///< Internal condition variable
+    std::atomic<std::size_t> m_spin_budget;        ///< Spin iterations before parking
+    std::atomic<std::size_t> m_notifications{0};   ///< Number of notifications, watched by spinning threads
+    std::atomic<std::size_t> m_parked_threads{0};  ///< Number of threads waiting on the condition variable
+
+    /**
+     * @brief Spins until the predicate is true or the spin budget is exhausted, then parks
+     *
+     * @pre The lock must be locked, it is locked again when the function returns
+     *
+     * @param lock Lock of the internal mutex
+     * @param predicate Callable which is checked whenever a notification arrives
+     * @param park Callable which parks the thread on the condition variable and returns the predicate
+     *
+     * @returns True if the predicate is true, false if parking gave up
+     */
+    template<typename Predicate, typename Park>
+    bool spinThenPark(std::unique_lock<MutexType> &lock, Predicate &predicate, Park &&park) {
+        const auto spin_budget{m_spin_budget.load(std::memory_order_relaxed)};
+        std::size_t spins{0};
+
+        while (!predicate()) {
+            if (spins >= spin_budget) {
+                // Pairs with the fence of lock-free producers, see pool_party::detail::Sync
+                ++m_parked_threads;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const bool is_satisfied{park(lock)};
+                --m_parked_threads;
+                return is_satisfied;
+            }
+
+            // Read within the critical section, so each notification after the check changes it
+            const auto notifications{m_notifications.load(std::memory_order_relaxed)};
+            lock.unlock();
+            while (spins < spin_budget && m_notifications.load(std::memory_order_relaxed) == notifications) {
+                spinOnce(spins++);
+            }
+            lock.lock();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Single iteration of busy waiting
+     *
+     * The first iterations only pause the processor, later ones give up the time slice, so
+     * spinning threads don't starve the producers on oversubscribed machines.
+     *
+     * @param spin Number of the iteration
+     */
+    static void spinOnce(std::size_t spin) {
+        if (spin < pause_spins) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+template<typename MutexType, typename ConditionVariableType>
+constexpr std::size_t SpinSync<MutexType, ConditionVariableType>::default_spin_budget;
+
+template<typename MutexType, typename ConditionVariableType>
+constexpr std::size_t SpinSync<MutexType, ConditionVariableType>::pause_spins;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_SPIN_SYNC_HPP_
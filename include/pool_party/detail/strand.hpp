@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_STRAND_HPP_
+#define POOL_PARTY_DETAIL_STRAND_HPP_
+
+#include "mpsc_queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Key of a strand, tasks with the same key are executed one after another in push order
+ *
+ * Keys of other types, like strings, can be mapped with a hash. Colliding hashes only serialize
+ * tasks which could have run in parallel.
+ */
+struct StrandKey {
+    /**
+     * @brief Constructor of StrandKey
+     *
+     * @param key Value which identifies the strand
+     */
+    explicit StrandKey(std::size_t key) : value{key} {}
+
+    std::size_t value;  ///< Value which identifies the strand
+};
+
+/**
+ * @brief Lock-free queue of the pending tasks of a single key
+ *
+ * The number of pending tasks is the ownership token of the strand. The producer whose push
+ * makes a strand busy has to schedule it, the scheduled drain owns the strand until it releases
+ * all tasks it executed and the number of pending tasks drops back to zero. Therefore at most one
+ * thread executes the tasks of a strand at a time, but it can be a different thread per drain.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class Strand {
+public:
+    /**
+     * @brief Constructor of an idle Strand
+     *
+     * @param key Key of the strand
+     */
+    explicit Strand(StrandKey key) : m_key{key} {}
+    Strand(const Strand&)            = delete;
+    Strand(Strand&&)                 = delete;
+    Strand& operator=(const Strand&) = delete;
+    Strand& operator=(Strand&&)      = delete;
+    ~Strand()                        = default;
+
+    /**
+     * @brief Key of the strand
+     */
+    StrandKey getKey() const {
+        return m_key;
+    }
+
+    /**
+     * @brief Announces a task which is pushed afterwards
+     *
+     * @returns True if the strand was idle and the caller has to schedule it
+     */
+    bool announce() {
+        return m_pending_tasks.fetch_add(1) == 0;
+    }
+
+    /**
+     * @brief Pushes an announced task, can be called from any thread
+     *
+     * @param task Task to push
+     */
+    void push(Task&& task) {
+        m_tasks.push(std::move(task));
+    }
+
+    /**
+     * @brief Takes the oldest task
+     *
+     * Waits until the task is visible if its producer announced it but did not finish the push yet.
+     *
+     * @pre Must only be called by the owner of the strand while a task is pending
+     *
+     * @returns The oldest task
+     */
+    Task pop() {
+        Task task{};
+        while (!m_tasks.tryPop(task)) {
+            std::this_thread::yield();
+        }
+        return task;
+    }
+
+    /**
+     * @brief Checks if more tasks are pending than the owner already took
+     *
+     * @param number_of_taken_tasks Number of tasks which the owner took since its last release
+     */
+    bool hasMoreTasks(std::size_t number_of_taken_tasks) const {
+        return m_pending_tasks.load() > number_of_taken_tasks;
+    }
+
+    /**
+     * @brief Releases the tasks which the owner took
+     *
+     * @param number_of_taken_tasks Number of tasks which the owner took since its last release
+     *
+     * @returns True if the strand became idle, the caller does not own it anymore then
+     */
+    bool release(std::size_t number_of_taken_tasks) {
+        return m_pending_tasks.fetch_sub(number_of_taken_tasks) == number_of_taken_tasks;
+    }
+
+    /**
+     * @brief Checks if no task is pending
+     */
+    bool isIdle() const {
+        return m_pending_tasks.load() == 0;
+    }
+
+private:
+    const StrandKey m_key;                        ///< Key of the strand
+    std::atomic<std::size_t> m_pending_tasks{0};  ///< Number of announced tasks which were not released
+    MpscQueue<Task> m_tasks{};                    ///< Pushed tasks in push order
+};
+
+/**
+ * @brief Maps keys to their strands
+ *
+ * Busy strands are kept in a hash map which is split into stripes with a mutex each. The mutex is
+ * only taken to find the strand of a push and to drop a strand which became idle, pushing and
+ * executing the tasks itself is lock-free. Dropping idle strands keeps the memory bounded by the
+ * number of busy keys.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class StrandRegistry {
+public:
+    using StrandPtr = std::shared_ptr<Strand<Task>>;
+
+    static constexpr std::size_t number_of_stripes{16};  ///< Number of independently locked parts of the map
+
+    /**
+     * @brief Pushes a task to the strand of its key
+     *
+     * @param key Key of the strand
+     * @param task Task to push
+     *
+     * @returns The strand if it was idle and the caller has to schedule it, nullptr otherwise
+     */
+    StrandPtr push(StrandKey key, Task&& task) {
+        auto& stripe{getStripe(key)};
+        StrandPtr strand{};
+        bool is_idle{false};
+        {
+            std::lock_guard<std::mutex> lg{stripe.mtx};
+            auto& entry{stripe.strands[key.value]};
+            if (!entry) {
+                entry = std::make_shared<Strand<Task>>(key);
+            }
+            strand  = entry;
+            is_idle = strand->announce();
+        }
+
+        strand->push(std::move(task));
+        return is_idle ? strand : nullptr;
+    }
+
+    /**
+     * @brief Releases the tasks which the owner of a strand took and drops the strand if it became idle
+     *
+     * A push which finds the strand before it is dropped makes it busy again, then the strand is kept.
+     *
+     * @param strand The owned strand
+     * @param number_of_taken_tasks Number of tasks which the owner took since its last release
+     *
+     * @returns True if the strand became idle, the caller does not own it anymore then
+     */
+    bool release(const StrandPtr& strand, std::size_t number_of_taken_tasks) {
+        if (!strand->release(number_of_taken_tasks)) {
+            return false;
+        }
+
+        auto& stripe{getStripe(strand->getKey())};
+        std::lock_guard<std::mutex> lg{stripe.mtx};
+        auto it{stripe.strands.find(strand->getKey().value)};
+        if (it != stripe.strands.end() && it->second == strand && strand->isIdle()) {
+            stripe.strands.erase(it);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Drops all pending tasks of a strand which cannot be scheduled
+     *
+     * @param strand The owned strand
+     */
+    void discard(const StrandPtr& strand) {
+        do {
+            strand->pop();
+        } while (!release(strand, 1));
+    }
+
+    /**
+     * @brief Number of strands with pending tasks
+     */
+    std::size_t size() {
+        std::size_t number_of_strands{0};
+        for (auto& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lg{stripe.mtx};
+            number_of_strands += stripe.strands.size();
+        }
+        return number_of_strands;
+    }
+
+private:
+    /**
+     * @brief Independently locked part of the map
+     */
+    struct Stripe {
+        std::mutex mtx{};                                      ///< Guards the map of the stripe
+        std::unordered_map<std::size_t, StrandPtr> strands{};  ///< Busy strands of the stripe
+    };
+
+    std::array<Stripe, number_of_stripes> m_stripes{};  ///< Stripes of the map
+
+    Stripe& getStripe(StrandKey key) {
+        return m_stripes[key.value % number_of_stripes];
+    }
+};
+
+template<typename Task>
+constexpr std::size_t StrandRegistry<Task>::number_of_stripes;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_STRAND_HPP_
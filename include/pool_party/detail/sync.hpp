@@ -23,6 +23,9 @@
 #ifndef POOL_PARTY_DETAIL_SYNC_HPP_
 #define POOL_PARTY_DETAIL_SYNC_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <mutex>
 #include <utility>
@@ -33,6 +36,10 @@ namespace detail {
 /**
  * @brief Class to synchronize pool threads
  *
+ * The sync object counts the threads which are parked on its condition variable. Notifications
+ * are skipped while no thread is parked, so notifying busy workers costs a single atomic load
+ * instead of a call into the condition variable.
+ *
  * @tparam MutexType Mutex type which is used for synchronization
  * @tparam ConditionVariableType CV type which is used for synced waiting
  */
@@ -44,7 +51,8 @@ public:
      * @brief Blocking waitThenExecute until sync object is notified
      *
      * This function can be called from multiple threads which all block
-     * until the sync gets notified and the predicate is true.
+     * until the sync gets notified and the predicate is true. The predicate is checked before
+     * the thread parks, so a true predicate doesn't wait at all.
      *
      * @tparam Predicate Callable type for checking function
      *
@@ -56,22 +64,80 @@ public:
     template<typename Predicate, typename Callable>
     void waitThenExecute(Predicate &&predicate, Callable &&locked_func) {
         std::unique_lock<MutexType> ul{m_mtx};
-        m_cv.wait(ul, std::forward<Predicate>(predicate));
+        if (!predicate()) {
+            // Counted while holding the mutex, so notifiers which pass the mutex afterwards see it.
+            // The fence pairs with the fence of lock-free producers, either the wait re-checks the
+            // predicate after their push or they see the parked thread.
+            ++m_parked_threads;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_cv.wait(ul, std::forward<Predicate>(predicate));
+            --m_parked_threads;
+        }
+        locked_func(ul);
+    }
+
+    /**
+     * @brief Blocking waitThenExecute with a timeout
+     *
+     * Works like waitThenExecute, but gives up when the predicate is still false after the
+     * timeout.
+     *
+     * @tparam Predicate Callable type for checking function
+     *
+     * @param timeout Maximum duration to wait for the predicate
+     * @param predicate Callable which is checked to be true when sync woke up
+     * @param locked_func Callable which is called in a synchronized scope, only if the predicate
+     *                    became true
+     *
+     * @returns True if the predicate became true and locked_func was called, false on timeout
+     */
+    template<typename Rep, typename Period, typename Predicate, typename Callable>
+    bool waitForThenExecute(const std::chrono::duration<Rep, Period> &timeout,
+                            Predicate &&predicate,
+                            Callable &&locked_func) {
+        std::unique_lock<MutexType> ul{m_mtx};
+        if (!predicate()) {
+            ++m_parked_threads;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool is_satisfied{m_cv.wait_for(ul, timeout, std::forward<Predicate>(predicate))};
+            --m_parked_threads;
+            if (!is_satisfied) {
+                return false;
+            }
+        }
         locked_func(ul);
+        return true;
     }
 
     /**
-     * @brief Notifies one waiting thread
+     * @brief Notifies one waiting thread, if any thread is parked
+     *
+     * @pre Changes of the wait predicate must be published under the mutex before
      */
     void notifyOne() {
-        m_cv.notify_one();
+        if (m_parked_threads.load() != 0) {
+            m_cv.notify_one();
+        }
     }
 
     /**
-     * @brief Notifies all waiting threads
+     * @brief Notifies all waiting threads, if any thread is parked
+     *
+     * @pre Changes of the wait predicate must be published under the mutex before
      */
     void notifyAll() {
-        m_cv.notify_all();
+        if (m_parked_threads.load() != 0) {
+            m_cv.notify_all();
+        }
+    }
+
+    /**
+     * @brief Getter for the number of threads which are parked on the condition variable
+     *
+     * @returns Number of parked threads, may be outdated when other threads wait or wake up
+     */
+    std::size_t getParkedThreads() const {
+        return m_parked_threads.load();
     }
 
     /**
@@ -106,8 +172,9 @@ public:
     }
 
 private:
-    MutexType m_mtx{};             ///< Internal mutex
-    ConditionVariableType m_cv{};  ///< Internal condition variable
+    MutexType m_mtx{};                             ///< Internal mutex
+    ConditionVariableType m_cv{};                  ///< Internal condition variable
+    std::atomic<std::size_t> m_parked_threads{0};  ///< Number of threads waiting on the condition variable
 };
 
 }  // namespace detail
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_TASK_HPP_
+#define POOL_PARTY_DETAIL_TASK_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Layout constants of pool_party::detail::Task
+ *
+ * A class template, so the constants have their out-of-class definition in this header without
+ * violating the one definition rule under C++11.
+ */
+template<typename = void>
+struct TaskLayout {
+    static constexpr std::size_t inline_capacity{48};  ///< Size of the inline buffer in bytes
+};
+
+template<typename Unused>
+constexpr std::size_t TaskLayout<Unused>::inline_capacity;
+
+/**
+ * @brief Move-only type erased task
+ *
+ * A task wraps any callable which can be called without arguments. In contrast to
+ * std::function or std::packaged_task, callables which fit into the inline buffer are stored
+ * without allocating memory. Larger callables and callables whose move constructor may throw are
+ * stored on the heap.
+ *
+ * The return value of the callable is discarded.
+ */
+class Task : public TaskLayout<> {
+public:
+    /**
+     * @brief Constructor of an empty task
+     */
+    Task() noexcept = default;
+
+    /**
+     * @brief Constructor of Task
+     *
+     * @tparam Callable Type of the wrapped callable
+     *
+     * @param callable The callable which is moved or copied into the task
+     */
+    template<typename Callable,
+             typename StoredType = typename std::decay<Callable>::type,
+             typename            = typename std::enable_if<!std::is_same<StoredType, Task>::value>::type>
+    explicit Task(Callable&& callable) {
+        construct<StoredType>(std::forward<Callable>(callable),
+                              std::integral_constant<bool, isStoredInline<StoredType>()>{});
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    /**
+     * @brief Move constructor, the moved-from task is empty afterwards
+     */
+    Task(Task&& other) noexcept {
+        takeFrom(other);
+    }
+
+    /**
+     * @brief Move assignment, the moved-from task is empty afterwards
+     */
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor releases the wrapped callable
+     */
+    ~Task() {
+        reset();
+    }
+
+    /**
+     * @brief Calls the wrapped callable
+     *
+     * @pre The task must not be empty
+     */
+    void operator()() {
+        m_invoke(m_storage);
+    }
+
+    /**
+     * @brief Checks if the task wraps a callable
+     *
+     * @returns True if a callable is wrapped, false for empty tasks
+     */
+    explicit operator bool() const noexcept {
+        return m_invoke != nullptr;
+    }
+
+    /**
+     * @brief Checks if a callable type is stored without allocating memory
+     *
+     * @tparam Callable Type of the callable
+     *
+     * @returns True if the callable is stored in the inline buffer, false otherwise
+     */
+    template<typename Callable>
+    static constexpr bool isStoredInline() {
+        return sizeof(Callable) <= sizeof(StorageType) && alignof(Callable) <= alignof(StorageType) &&
+               std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+private:
+    using StorageType = typename std::aligned_storage<inline_capacity, alignof(std::max_align_t)>::type;
+
+    enum class Operation { move, destroy };
+
+    using InvokeFunction = void (*)(StorageType&);
+    using ManageFunction = void (*)(Operation, StorageType&, StorageType*);
+
+    StorageType m_storage;             ///< Inline buffer, holds the callable or a pointer to it
+    InvokeFunction m_invoke{nullptr};  ///< Calls the stored callable, nullptr for empty tasks
+    ManageFunction m_manage{nullptr};  ///< Moves or destroys the stored callable, nullptr for empty tasks
+
+    template<typename StoredType, typename Callable>
+    void construct(Callable&& callable, std::true_type /*stored_inline*/) {
+        new (&m_storage) StoredType(std::forward<Callable>(callable));
+        m_invoke = &invokeInline<StoredType>;
+        m_manage = &manageInline<StoredType>;
+    }
+
+    template<typename StoredType, typename Callable>
+    void construct(Callable&& callable, std::false_type /*stored_inline*/) {
+        new (&m_storage) StoredType*(new StoredType(std::forward<Callable>(callable)));
+        m_invoke = &invokeHeap<StoredType>;
+        m_manage = &manageHeap<StoredType>;
+    }
+
+    template<typename StoredType>
+    static void invokeInline(StorageType& storage) {
+        (*reinterpret_cast<StoredType*>(&storage))();
+    }
+
+    template<typename StoredType>
+    static void manageInline(Operation operation, StorageType& storage, StorageType* target) {
+        auto* stored{reinterpret_cast<StoredType*>(&storage)};
+        if (operation == Operation::move) {
+            new (target) StoredType(std::move(*stored));
+        }
+        stored->~StoredType();
+    }
+
+    template<typename StoredType>
+    static void invokeHeap(StorageType& storage) {
+        (**reinterpret_cast<StoredType**>(&storage))();
+    }
+
+    template<typename StoredType>
+    static void manageHeap(Operation operation, StorageType& storage, StorageType* target) {
+        auto* stored{*reinterpret_cast<StoredType**>(&storage)};
+        if (operation == Operation::move) {
+            new (target) StoredType*(stored);
+        } else {
+            delete stored;
+        }
+    }
+
+    void takeFrom(Task& other) noexcept {
+        if (other.m_manage != nullptr) {
+            other.m_manage(Operation::move, other.m_storage, &m_storage);
+        }
+        m_invoke       = other.m_invoke;
+        m_manage       = other.m_manage;
+        other.m_invoke = nullptr;
+        other.m_manage = nullptr;
+    }
+
+    void reset() noexcept {
+        if (m_manage != nullptr) {
+            m_manage(Operation::destroy, m_storage, nullptr);
+        }
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+};
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_TASK_HPP_
@@ -23,6 +23,7 @@
 #ifndef POOL_PARTY_DETAIL_THREAD_FACTORY_HPP_
 #define POOL_PARTY_DETAIL_THREAD_FACTORY_HPP_
 
+#include <cstddef>
 #include <utility>
 
 namespace pool_party {
@@ -50,6 +51,44 @@ public:
         return ThreadType{std::forward<Callable>(thread_function), std::forward<Args>(args)...};
     }
 };
+
+/**
+ * @brief Creates a worker thread with a factory which places workers by index
+ *
+ * Preferred overload of createWorkerThread for factories with a createWorker(std::size_t, Callable)
+ * function.
+ */
+template<typename Factory, typename Callable>
+auto createWorkerThread(Factory& factory, std::size_t worker_index, Callable&& thread_function, int)
+    -> decltype(factory.createWorker(worker_index, std::forward<Callable>(thread_function))) {
+    return factory.createWorker(worker_index, std::forward<Callable>(thread_function));
+}
+
+/**
+ * @brief Creates a worker thread with a factory which doesn't place workers by index
+ */
+template<typename Factory, typename Callable>
+auto createWorkerThread(Factory& factory, std::size_t, Callable&& thread_function, long)
+    -> decltype(factory.create(std::forward<Callable>(thread_function))) {
+    return factory.create(std::forward<Callable>(thread_function));
+}
+
+/**
+ * @brief Creates the thread of a pool worker
+ *
+ * Factories with a createWorker(std::size_t, Callable) function receive the worker index, e.g. to
+ * pin the worker to a CPU which depends on its index. Other factories create the thread with
+ * create(Callable).
+ *
+ * @param factory Factory which creates the thread
+ * @param worker_index Index of the worker within its pool
+ * @param thread_function The callable function which is passed to the thread.
+ */
+template<typename Factory, typename Callable>
+auto createWorkerThread(Factory& factory, std::size_t worker_index, Callable&& thread_function)
+    -> decltype(createWorkerThread(factory, worker_index, std::forward<Callable>(thread_function), 0)) {
+    return createWorkerThread(factory, worker_index, std::forward<Callable>(thread_function), 0);
+}
 }  // namespace detail
 }  // namespace pool_party
 
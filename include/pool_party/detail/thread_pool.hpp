@@ -23,19 +23,77 @@
 #ifndef POOL_PARTY_DETAIL_THREAD_POOL_HPP_
 #define POOL_PARTY_DETAIL_THREAD_POOL_HPP_
 
+#include "bound_callable.hpp"
+#include "cache_line.hpp"
+#include "cancellation.hpp"
+#include "fifo_queue.hpp"
+#include "future.hpp"
+#include "hill_climbing.hpp"
+#include "in_flight_counter.hpp"
+#include "priority_queue.hpp"
+#include "queue_tags.hpp"
+#include "strand.hpp"
+#include "task.hpp"
+#include "thread_factory.hpp"
 #include "thread_joiner.hpp"
+#include "timer_wheel.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace pool_party {
 namespace detail {
 
+/**
+ * @brief Bounds and thresholds of a thread pool whose number of workers follows the load
+ *
+ * Setting a control interval enables the hill climbing controller, which additionally caps the
+ * number of workers at the target with the highest measured throughput.
+ *
+ * @see pool_party::detail::HillClimbing
+ */
+struct ElasticLimits {
+    /**
+     * @brief Constructor of ElasticLimits
+     *
+     * @param min_workers Number of workers which are kept alive while idle, at least one
+     * @param max_workers Upper limit of workers
+     * @param keep_alive_duration Idle duration after which a worker above the minimum retires
+     * @param backlog Number of queued tasks which adds a worker while none is idle
+     */
+    ElasticLimits(std::size_t min_workers,
+                  std::size_t max_workers,
+                  std::chrono::milliseconds keep_alive_duration = std::chrono::seconds{60},
+                  std::size_t backlog                           = 1) :
+            min_threads{min_workers},
+            max_threads{max_workers},
+            keep_alive{keep_alive_duration},
+            backlog_threshold{std::max<std::size_t>(backlog, 1)},
+            control_interval{0} {}
+
+    std::size_t min_threads;                     ///< Number of workers which are kept alive while idle
+    std::size_t max_threads;                     ///< Upper limit of workers
+    std::chrono::milliseconds keep_alive;        ///< Idle duration after which a worker above the minimum retires
+    std::size_t backlog_threshold;               ///< Number of queued tasks which adds a worker while none is idle
+    std::chrono::milliseconds control_interval;  ///< Sampling interval of the controller, zero disables it
+};
+
 /**
  * @brief ThreadPool detail implementation
  *
@@ -43,14 +101,19 @@ namespace detail {
  *
  * @tparam ThreadFactory, a dependency for thread creation
  * @tparam Sync manages the synchronization between threads of the thread pool
+ * @tparam Queue task queue template which decides how tasks are distributed to the workers
  *
  * @see pool_party::detail::Sync
  * @see pool_party::detail::ThreadFactory
+ * @see pool_party::detail::FifoQueue
+ * @see pool_party::detail::MpmcRingQueue
+ * @see pool_party::detail::WorkStealingQueue
  */
-template<typename ThreadFactory, typename Sync>
+template<typename ThreadFactory, typename Sync, template<typename> class Queue = FifoQueue>
 class ThreadPool {
     using ThreadType       = typename ThreadFactory::thread_type;
     using ThreadJoinerType = ThreadJoiner<ThreadType>;
+    using TimerThreadType  = ThreadJoiner<std::thread>;
 
 public:
     /**
@@ -59,15 +122,58 @@ public:
      * This function creates all neccessary threads and prepares them to work on the
      * thread pools tasks.
      *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
      * @param number_of_threads The number of threads the thread pool should consist of.
      * @param thread_factory Takes care of thread creation
      * @param sync Handles synchronization of threads
+     * @param queue_args Additional arguments which are passed to the task queue constructor
      */
-    ThreadPool(std::size_t number_of_threads, ThreadFactory& thread_factory, Sync& sync) : m_sync{sync} {
-        m_workers.reserve(number_of_threads);
-        for (std::size_t current_thread{0}; current_thread < number_of_threads; ++current_thread) {
-            m_workers.push_back(ThreadJoinerType{thread_factory.create([this]() { work(); })});
-        }
+    template<typename... QueueArgs>
+    ThreadPool(std::size_t number_of_threads, ThreadFactory& thread_factory, Sync& sync, QueueArgs&&... queue_args) :
+            m_sync{sync},
+            m_thread_factory{thread_factory},
+            m_limits{number_of_threads, number_of_threads, std::chrono::milliseconds::max()},
+            m_tasks(number_of_threads, std::forward<QueueArgs>(queue_args)...),
+            m_batches(number_of_threads),
+            m_is_bounded{queueCapacity(m_tasks) != FifoQueue<TaskType>::unbounded},
+            m_pending_pushes(number_of_threads),
+            m_tasks_in_flight(number_of_threads),
+            m_controller{number_of_threads, number_of_threads, number_of_threads},
+            m_worker_target{number_of_threads} {
+        startWorkers(number_of_threads);
+    }
+
+    /**
+     * @brief Constructor of an elastic ThreadPool
+     *
+     * The pool starts with the minimum number of workers. After a push, a worker is added while
+     * no worker is parked and at least the backlog threshold of tasks is queued. Workers above
+     * the minimum retire after being idle for the keep alive duration. Concurrent queues only
+     * tell whether tasks are queued, there any backlog counts as a single task.
+     *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
+     * @param limits Bounds of the number of workers and thresholds for growing and shrinking
+     * @param thread_factory Takes care of thread creation, must outlive the pool
+     * @param sync Handles synchronization of threads
+     * @param queue_args Additional arguments which are passed to the task queue constructor
+     *
+     * @exception std::invalid_argument is thrown when the minimum is zero or above the maximum
+     */
+    template<typename... QueueArgs>
+    ThreadPool(const ElasticLimits& limits, ThreadFactory& thread_factory, Sync& sync, QueueArgs&&... queue_args) :
+            m_sync{sync},
+            m_thread_factory{thread_factory},
+            m_limits{validate(limits)},
+            m_tasks(limits.max_threads, std::forward<QueueArgs>(queue_args)...),
+            m_batches(limits.max_threads),
+            m_is_bounded{queueCapacity(m_tasks) != FifoQueue<TaskType>::unbounded},
+            m_pending_pushes(limits.max_threads),
+            m_tasks_in_flight(limits.max_threads),
+            m_controller{limits.min_threads, limits.max_threads, limits.min_threads},
+            m_worker_target{limits.min_threads} {
+        startWorkers(limits.min_threads);
     }
     ThreadPool(const ThreadPool&)            = default;
     ThreadPool(ThreadPool&&)                 = default;
@@ -79,6 +185,15 @@ public:
      */
     ~ThreadPool() {
         shutdown();
+
+        // No worker is added after the shutdown, the slots can be joined without holding the mutex
+        std::vector<std::unique_ptr<ThreadJoinerType>> workers{};
+        std::unique_ptr<TimerThreadType> timer_thread{};
+        {
+            std::lock_guard<std::mutex> lg{m_workers_mtx};
+            workers.swap(m_workers);
+            timer_thread.swap(m_timer_thread);
+        }
     }
 
     /**
@@ -90,6 +205,9 @@ public:
      * After signaling a shutdown, enqueuing new tasks is NOT allowed and punished with a
      * corresponding exception.
      *
+     * While a bounded task queue is full, the caller blocks until a worker frees a slot. Workers
+     * which enqueue into a full queue execute pending tasks meanwhile.
+     *
      * @tparam Callable Type of tasks function
      * @tparam Args Variadic template type of tasks function arguments
      * @tparam R Automatically generated result type
@@ -97,118 +215,1929 @@ public:
      * @param callable The callable which contains the task
      * @param args Variadic arguments which are passed to the tasks callable
      *
-     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::runtime_error is thrown when the thread pool is already shut down or shuts
+     *                               down while waiting for a free slot
      *
      * @returns std::future<R> with tasks result
      */
     template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
     std::future<R> enqueue(Callable&& callable, Args&&... args) {
-        std::packaged_task<R()> task{std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...)};
-        auto future{task.get_future()};
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        auto future{task.getFuture()};
 
-        m_sync.get().executeLocked([&task, this]() {
-            throwWhenPoolIsShutDown();
-            m_tasks.emplace_front(std::move(task));
-        });
-        m_sync.get().notifyOne();
+        pushTask(TaskType{std::move(task)});
 
         return future;
     }
 
     /**
-     * @brief Shutdown the thread pool
+     * @brief Enqueue a new task if the bounded task queue has room
      *
-     * This function signals a shutdown to all worker threads. The threads will process the
-     * remaining stored tasks. After shuting down the thread pool enqueuing is not allowed anymore.
+     * Fails fast instead of waiting for a free slot, so producers can shed load when the pool is
+     * overloaded. Unbounded queues always take the task.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result, an invalid future if the queue is full
      */
-    void shutdown() {
-        m_sync.get().executeLocked([this]() { is_shutdown = true; });
-        m_sync.get().notifyAll();
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> tryEnqueue(Callable&& callable, Args&&... args) {
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        return pushTaskUntil(std::move(task), Deadline::min());
     }
 
-private:
-    using TaskType     = std::packaged_task<void()>;
-    using TaskLockType = std::unique_lock<typename Sync::mutex_type>;
+    /**
+     * @brief Enqueue a new task, waiting at most the timeout for room in the bounded task queue
+     *
+     * @tparam Rep Arithmetic type of the timeout ticks
+     * @tparam Period Tick period of the timeout
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param timeout Maximum duration to wait for a free slot
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down or shuts
+     *                               down while waiting
+     *
+     * @returns std::future<R> with tasks result, an invalid future if the queue stayed full
+     */
+    template<typename Rep,
+             typename Period,
+             typename Callable,
+             typename... Args,
+             typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueueFor(const std::chrono::duration<Rep, Period>& timeout, Callable&& callable, Args&&... args) {
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        const auto deadline{std::chrono::steady_clock::now() + std::chrono::duration_cast<Deadline::duration>(timeout)};
+        return pushTaskUntil(std::move(task), deadline);
+    }
 
-    std::reference_wrapper<Sync> m_sync{};      ///< Reference to used synchronization object
-    std::deque<TaskType> m_tasks{};             ///< Task queue which stores tasks with fifo strategy
-    std::vector<ThreadJoinerType> m_workers{};  ///< Vector of thread pools worker threads
-    bool is_shutdown{false};                    ///< Boolean for internal shutdown state
+    /**
+     * @brief Post a new task without result
+     *
+     * In contrast to enqueue, no future and therefore no shared state is created for the task.
+     * Exceptions which escape the task are passed to the exception handler.
+     *
+     * After signaling a shutdown, posting new tasks is NOT allowed and punished with a
+     * corresponding exception.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @see pool_party::detail::ThreadPool::setExceptionHandler
+     */
+    template<typename Callable, typename... Args>
+    void post(Callable&& callable, Args&&... args) {
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        pushTask(TaskType{std::move(task)});
+    }
 
     /**
-     * @brief Worker function
+     * @brief Submit a new task whose result is consumed by continuations
      *
-     * Each thread of the thread pool calls this function initially. The threads are either waiting
-     * in this function or processing the incoming tasks.
+     * In contrast to enqueue, the returned future has a lock-free shared state. Continuations
+     * which are attached with pool_party::detail::Future::then are scheduled on this pool when
+     * the result is ready.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns pool_party::detail::Future<R> with tasks result
      */
-    void work() {
-        auto check_wait_condition{[this]() { return hasWork() || is_shutdown; }};
-        auto execute_oldest_task{[this](TaskLockType& lock) { executeOldestTask(lock); }};
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    Future<R> submit(Callable&& callable, Args&&... args) {
+        using StateType = typename Future<R>::StateType;
+        auto state{std::make_shared<StateType>(&scheduleContinuation, this)};
 
-        while (!is_shutdown || hasWork()) {
-            m_sync.get().waitThenExecute(check_wait_condition, execute_oldest_task);
-        }
+        auto bound{bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...)};
+        pushTask(TaskType{SubmittedTask<StateType, decltype(bound)>{state, std::move(bound)}});
+
+        return Future<R>{std::move(state)};
     }
 
     /**
-     * @brief Checks if thread pool has work to do
+     * @brief Enqueue a new task with a priority
+     *
+     * Only available for queues with priority levels, like pool_party::detail::PriorityQueue.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
      *
-     * @returns True if tasks are queued, false otherwise
+     * @param priority Priority of the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
      */
-    bool hasWork() {
-        return !m_tasks.empty();
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(Priority priority, Callable&& callable, Args&&... args) {
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        auto future{task.getFuture()};
+        pushTaskWithPriority(TaskType{std::move(task)}, priority);
+        return future;
     }
 
     /**
-     * @brief Executes the oldest task from the task queue
+     * @brief Post a new task without result with a priority
      *
-     * This function either executes and removes the oldest task in the queue or finishes
-     * directly when no task is remaining. The lock is unlocked before the task function
-     * is executed to allow other tasks executions in parallel.
+     * Only available for queues with priority levels, like pool_party::detail::PriorityQueue.
      *
-     * @pre taskQueueLock must be already locked when function is executed
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
      *
-     * @param taskQueueLock A unique lock which protectes the queue
+     * @param priority Priority of the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
      */
-    void executeOldestTask(TaskLockType& taskQueueLock) {
-        if (!hasWork()) {
-            return;
-        }
+    template<typename Callable, typename... Args>
+    void post(Priority priority, Callable&& callable, Args&&... args) {
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        pushTaskWithPriority(TaskType{std::move(task)}, priority);
+    }
 
-        auto task{popOldestTaskFromQueue()};
-        taskQueueLock.unlock();
-        task();
+    /**
+     * @brief Enqueue a new task on a strand
+     *
+     * Tasks with the same key are executed in the order they were enqueued and never in
+     * parallel, tasks with different keys run in parallel. A strand occupies at most one worker,
+     * which takes a batch of its tasks and then hands the strand over to the next free worker.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param key Key of the strand
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(StrandKey key, Callable&& callable, Args&&... args) {
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        auto future{task.getFuture()};
+        pushTaskToStrand(TaskType{std::move(task)}, key);
+        return future;
     }
 
     /**
-     * @brief Gets and removes the oldest task from the queue
+     * @brief Post a new task without result on a strand
      *
-     * @pre This function must be used in critical section
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param key Key of the strand
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
      *
-     * @returns Oldest tasks from queue
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
      */
-    TaskType popOldestTaskFromQueue() {
-        auto task{std::move(m_tasks.back())};
-        m_tasks.pop_back();
-        return task;
+    template<typename Callable, typename... Args>
+    void post(StrandKey key, Callable&& callable, Args&&... args) {
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        pushTaskToStrand(TaskType{std::move(task)}, key);
     }
 
     /**
-     * @brief Throws exception when shutdown state is set
+     * @brief Enqueue a new task which can be cancelled
      *
-     * @pre This function must be used in critical section
+     * A task whose token is cancelled before a worker starts it is skipped without calling the
+     * callable, its future receives pool_party::detail::TaskCancelled. Running tasks can poll
+     * the token themselves, e.g. by capturing a copy of it.
      *
-     * @exception std::runtime_error is thrown when the thread pool is already shut down and the
-     * client is trying to enqueue tasks
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
      *
-     * @see pool_party::detail::ThreadPool::enqueue
+     * @param token Token which cancels the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
      */
-    void throwWhenPoolIsShutDown() {
-        if (is_shutdown) {
-            throw std::runtime_error{"Thread pool already shut down, enqueuing failed."};
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(CancellationToken token, Callable&& callable, Args&&... args) {
+        auto bound{bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...)};
+        auto task{makePromisedTask<R>(CancellableCallable<decltype(bound)>{std::move(token), std::move(bound)})};
+        auto future{task.getFuture()};
+        pushTask(TaskType{std::move(task)});
+        return future;
+    }
+
+    /**
+     * @brief Post a new task without result which can be cancelled
+     *
+     * A task whose token is cancelled before a worker starts it is skipped without calling the
+     * callable. Neither skipped tasks nor tasks which throw pool_party::detail::TaskCancelled are
+     * reported to the exception handler.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param token Token which cancels the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable, typename... Args>
+    void post(CancellationToken token, Callable&& callable, Args&&... args) {
+        auto bound{bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...)};
+        pushTask(TaskType{makePostedTask(CancellableCallable<decltype(bound)>{std::move(token), std::move(bound)})});
+    }
+
+    /**
+     * @brief Schedule a task without result to run once after a delay
+     *
+     * The task waits in a timer wheel instead of occupying a worker. The wheel is serviced by a
+     * timer thread, which the pool creates with the first timer and which pushes due tasks into
+     * the task queue. The timer thread is a std::thread which is not created by the thread
+     * factory, so it is never pinned. Timers have a resolution of one millisecond and never fire
+     * early. Pending timers are dropped on shutdown.
+     *
+     * @tparam Rep Arithmetic type of the delay
+     * @tparam Period Tick period of the delay
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param delay Duration after which the task is pushed into the task queue
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Rep, typename Period, typename Callable, typename... Args>
+    TimerId scheduleAfter(const std::chrono::duration<Rep, Period>& delay, Callable&& callable, Args&&... args) {
+        const auto time{std::chrono::steady_clock::now() + std::chrono::duration_cast<Deadline::duration>(delay)};
+        return scheduleAt(time, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Schedule a task without result to run once at a point in time
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param time Point in time at which the task is pushed into the task queue
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Callable, typename... Args>
+    TimerId scheduleAt(std::chrono::steady_clock::time_point time, Callable&& callable, Args&&... args) {
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        return addTimer(toTimerTick(time), 0, TaskType{std::move(task)});
+    }
+
+    /**
+     * @brief Schedule a task without result to run periodically
+     *
+     * The first run is due after one period. A run is skipped while the previous run of the same
+     * timer is still executing, missed periods are not caught up.
+     *
+     * @tparam Rep Arithmetic type of the period
+     * @tparam Period Tick period of the period
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param period Duration between two runs, at least one millisecond
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Rep, typename Period, typename Callable, typename... Args>
+    TimerId scheduleEvery(const std::chrono::duration<Rep, Period>& period, Callable&& callable, Args&&... args) {
+        const auto period_duration{std::chrono::duration_cast<Deadline::duration>(period)};
+        const auto period_ticks{std::max<std::uint64_t>(toTimerTick(m_timers_epoch + period_duration), 1)};
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        return addTimer(
+        toTimerTick(std::chrono::steady_clock::now() + period_duration), period_ticks, TaskType{std::move(task)});
+    }
+
+    /**
+     * @brief Cancel a scheduled task
+     *
+     * A due run which already waits in the task queue is skipped as well.
+     *
+     * @param id Handle of the timer
+     *
+     * @returns True if the timer was cancelled, false if it already fired or was cancelled before
+     */
+    bool cancelTimer(TimerId id) {
+        std::lock_guard<std::mutex> lg{m_timers_mtx};
+        auto* scheduled_task{m_timers.find(id)};
+        if (scheduled_task == nullptr) {
+            return false;
         }
+        (*scheduled_task)->is_cancelled = true;
+        return m_timers.cancel(id);
     }
-};
+
+    /**
+     * @brief Enqueue a new task for a specific NUMA node
+     *
+     * Only available for queues with node placement, like pool_party::detail::NumaQueue.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param node Id of the NUMA node whose workers should execute the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::out_of_range is thrown when the node is not available
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueueOn(std::size_t node, Callable&& callable, Args&&... args) {
+        auto task{makePromisedTask<R>(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        auto future{task.getFuture()};
+        pushTaskToNode(TaskType{std::move(task)}, node);
+        return future;
+    }
+
+    /**
+     * @brief Post a new task without result for a specific NUMA node
+     *
+     * Only available for queues with node placement, like pool_party::detail::NumaQueue.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param node Id of the NUMA node whose workers should execute the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::out_of_range is thrown when the node is not available
+     */
+    template<typename Callable, typename... Args>
+    void postOn(std::size_t node, Callable&& callable, Args&&... args) {
+        auto task{makePostedTask(bindArguments(std::forward<Callable>(callable), std::forward<Args>(args)...))};
+        pushTaskToNode(TaskType{std::move(task)}, node);
+    }
+
+    /**
+     * @brief Enqueue a range of tasks at once
+     *
+     * All tasks are pushed to the queue at once and only as many workers as needed are notified.
+     * Each callable of the range is copied into its task.
+     *
+     * @tparam ForwardIterator Iterator type of the callable range
+     * @tparam R Automatically generated result type
+     *
+     * @param first Iterator to the first callable
+     * @param last Iterator behind the last callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::vector of futures with the tasks results in the order of the range
+     */
+    template<typename ForwardIterator,
+             typename R = typename std::result_of<typename std::iterator_traits<ForwardIterator>::reference()>::type>
+    std::vector<std::future<R>> enqueueBulk(ForwardIterator first, ForwardIterator last) {
+        using CallableType = typename std::iterator_traits<ForwardIterator>::value_type;
+
+        const auto number_of_tasks{static_cast<std::size_t>(std::distance(first, last))};
+        std::vector<TaskType> tasks{};
+        std::vector<std::future<R>> futures{};
+        tasks.reserve(number_of_tasks);
+        futures.reserve(number_of_tasks);
+
+        for (; first != last; ++first) {
+            auto task{makePromisedTask<R>(CallableType{*first})};
+            futures.push_back(task.getFuture());
+            tasks.emplace_back(std::move(task));
+        }
+        pushTasks(tasks.data(), tasks.data() + tasks.size());
+
+        return futures;
+    }
+
+    /**
+     * @brief Enqueue a number of tasks which call the same callable with their index
+     *
+     * All tasks are pushed to the queue at once and only as many workers as needed are notified.
+     * The callable is copied into each task.
+     *
+     * @tparam Callable Type of tasks function, called with the std::size_t index of the task
+     * @tparam R Automatically generated result type
+     *
+     * @param number_of_tasks Number of tasks to enqueue
+     * @param callable The callable which is called by each task
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::vector of futures with the tasks results ordered by index
+     */
+    template<typename Callable, typename R = typename std::result_of<Callable&(std::size_t)>::type>
+    std::vector<std::future<R>> enqueueBulk(std::size_t number_of_tasks, Callable&& callable) {
+        std::vector<TaskType> tasks{};
+        std::vector<std::future<R>> futures{};
+        tasks.reserve(number_of_tasks);
+        futures.reserve(number_of_tasks);
+
+        for (std::size_t task_index{0}; task_index < number_of_tasks; ++task_index) {
+            auto task{makePromisedTask<R>(bindArguments(callable, task_index))};
+            futures.push_back(task.getFuture());
+            tasks.emplace_back(std::move(task));
+        }
+        pushTasks(tasks.data(), tasks.data() + tasks.size());
+
+        return futures;
+    }
+
+    /**
+     * @brief Post a range of tasks without results at once
+     *
+     * Works like enqueueBulk, but like post no futures are created.
+     *
+     * @tparam ForwardIterator Iterator type of the callable range
+     *
+     * @param first Iterator to the first callable
+     * @param last Iterator behind the last callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @see pool_party::detail::ThreadPool::post
+     */
+    template<typename ForwardIterator>
+    void postBulk(ForwardIterator first, ForwardIterator last) {
+        using CallableType = typename std::iterator_traits<ForwardIterator>::value_type;
+
+        std::vector<TaskType> tasks{};
+        tasks.reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first) {
+            tasks.emplace_back(makePostedTask(CallableType{*first}));
+        }
+        pushTasks(tasks.data(), tasks.data() + tasks.size());
+    }
+
+    /**
+     * @brief Post a number of tasks without results which call the same callable with their index
+     *
+     * Works like enqueueBulk, but like post no futures are created.
+     *
+     * @tparam Callable Type of tasks function, called with the std::size_t index of the task
+     *
+     * @param number_of_tasks Number of tasks to post
+     * @param callable The callable which is called by each task
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @see pool_party::detail::ThreadPool::post
+     */
+    template<typename Callable>
+    void postBulk(std::size_t number_of_tasks, Callable&& callable) {
+        std::vector<TaskType> tasks{};
+        tasks.reserve(number_of_tasks);
+        for (std::size_t task_index{0}; task_index < number_of_tasks; ++task_index) {
+            tasks.emplace_back(makePostedTask(bindArguments(callable, task_index)));
+        }
+        pushTasks(tasks.data(), tasks.data() + tasks.size());
+    }
+
+    /**
+     * @brief Sets the handler for exceptions which escape posted tasks
+     *
+     * The handler is called by the worker thread which executed the failed task. Without a
+     * handler, std::terminate is called.
+     *
+     * @param exception_handler Callable which receives the exception, an empty handler restores
+     *                          the default behaviour
+     */
+    void setExceptionHandler(std::function<void(std::exception_ptr)> exception_handler) {
+        m_sync.get().executeLocked(
+        [&exception_handler, this]() { m_exception_handler = std::move(exception_handler); });
+    }
+
+    /**
+     * @brief Sets the observer of the hill climbing controller
+     *
+     * The observer is called with every decision of the controller by the worker which took the
+     * sample. It must not block, since the worker doesn't execute tasks meanwhile.
+     *
+     * @param observer Callable which receives the decisions, an empty observer stops the notifications
+     */
+    void setConcurrencyObserver(std::function<void(const ConcurrencyDecision&)> observer) {
+        m_sync.get().executeLocked([&observer, this]() { m_concurrency_observer = std::move(observer); });
+    }
+
+    /**
+     * @brief Returns the upper limit of workers which is currently in effect
+     *
+     * @returns The target of the hill climbing controller, the maximum number of workers without controller
+     */
+    std::size_t getWorkerTarget() const {
+        return isControlled() ? m_worker_target.load() : m_limits.max_threads;
+    }
+
+    /**
+     * @brief Executes a pending task on the calling thread
+     *
+     * Allows threads which wait for the results of other tasks to make progress instead of
+     * blocking a worker. Workers take the task from their own part of the queue first.
+     *
+     * @returns True if a task was executed, false if no task was pending
+     */
+    bool tryExecuteTask() {
+        TaskType task{};
+        if (!tryPopTask(task, SynchronizationTag{})) {
+            return false;
+        }
+
+        task();
+        finishTasks(1);
+        return true;
+    }
+
+    /**
+     * @brief Blocks until no task is queued and no worker executes a task
+     *
+     * Serves as barrier between phases of work without keeping the futures of the tasks. Tasks of
+     * strands count as queued, pending timers don't. Tasks which are pushed while waiting extend
+     * the wait.
+     *
+     * @pre Must not be called by a task of this pool, which would wait for itself
+     */
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock{m_idle_mtx};
+        m_tasks_in_flight.addWaiter();
+        m_idle_cv.wait(lock, [this]() { return m_tasks_in_flight.isZero(); });
+        m_tasks_in_flight.removeWaiter();
+    }
+
+    /**
+     * @brief Blocks until no task is queued and no worker executes a task, or the timeout expires
+     *
+     * @tparam Rep Arithmetic type of the timeout
+     * @tparam Period Tick period of the timeout
+     *
+     * @param timeout Upper limit of the time to wait
+     *
+     * @returns True if the pool became idle, false on timeout
+     *
+     * @see pool_party::detail::ThreadPool::waitIdle
+     */
+    template<typename Rep, typename Period>
+    bool waitIdleFor(const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock{m_idle_mtx};
+        m_tasks_in_flight.addWaiter();
+        const bool is_idle{m_idle_cv.wait_for(lock, timeout, [this]() { return m_tasks_in_flight.isZero(); })};
+        m_tasks_in_flight.removeWaiter();
+        return is_idle;
+    }
+
+    /**
+     * @brief Returns the number of worker threads
+     */
+    std::size_t getNumberOfThreads() const {
+        return m_running_workers.load();
+    }
+
+    /**
+     * @brief Shutdown the thread pool
+     *
+     * This function signals a shutdown to all worker threads. The threads will process the
+     * remaining stored tasks. After shuting down the thread pool enqueuing is not allowed anymore.
+     */
+    void shutdown() {
+        m_sync.get().executeLocked([this]() { is_shutdown = true; });
+        m_sync.get().notifyAll();
+        wakeProducers();
+        stopTimers();
+    }
+
+    /**
+     * @brief Shutdown the thread pool without processing the queued tasks
+     *
+     * Workers stop taking tasks right away and finish after their current task. The queued tasks,
+     * including the not yet started tasks of batches which workers already took, are handed back
+     * to the caller, who can execute them elsewhere. Dropping them reports a broken promise to the
+     * futures of enqueue and submit.
+     *
+     * The queued tasks of a strand are handed back as a single task, which executes them in order.
+     * Handed back tasks may still refer to the pool, e.g. posted tasks report exceptions to its
+     * handler and continuations are scheduled on it. They have to be executed or dropped before
+     * the pool is destroyed.
+     *
+     * The function returns without waiting for the workers, tasks which are executed at the time
+     * of the call keep running. waitIdle blocks until they are finished, since the handed back
+     * tasks don't count as in flight anymore. The destructor joins the workers.
+     *
+     * @returns The tasks which were queued and not executed, those of taken batches first
+     */
+    std::vector<Task> shutdownNow() {
+        m_is_aborted = true;
+        shutdown();
+        auto tasks{takeQueuedTasks(SynchronizationTag{})};
+        finishTasks(tasks.size());
+        return tasks;
+    }
+
+    /**
+     * @brief Shutdown the thread pool and wait a limited time for the queued tasks
+     *
+     * Works like shutdown, but if the workers did not finish all tasks within the timeout, the
+     * remaining tasks are handed back like by shutdownNow.
+     *
+     * @tparam Rep Arithmetic type of the timeout
+     * @tparam Period Tick period of the timeout
+     *
+     * @param timeout Upper limit of the time to wait for the workers
+     *
+     * @returns The tasks which were queued and not executed, empty if all tasks were processed
+     */
+    template<typename Rep, typename Period>
+    std::vector<Task> shutdownFor(const std::chrono::duration<Rep, Period>& timeout) {
+        shutdown();
+
+        // A worker which shuts down its own pool can't finish while it waits
+        const std::size_t calling_workers{currentWorkerIndex() == no_worker_index ? 0U : 1U};
+        std::unique_lock<std::mutex> lock{m_workers_mtx};
+        auto are_workers_finished{[this, calling_workers]() { return m_live_workers == calling_workers; }};
+        if (m_workers_cv.wait_for(lock, timeout, are_workers_finished)) {
+            return {};
+        }
+        lock.unlock();
+        return shutdownNow();
+    }
+
+private:
+    using TaskType            = Task;
+    using TaskLockType        = std::unique_lock<typename Sync::mutex_type>;
+    using QueueType           = Queue<TaskType>;
+    using SynchronizationTag  = typename QueueType::synchronization_tag;
+    using ClockRep            = std::chrono::steady_clock::rep;
+    using Deadline            = std::chrono::steady_clock::time_point;
+    using ConcurrencyObserver = std::function<void(const ConcurrencyDecision&)>;
+    using StrandPtr           = typename StrandRegistry<TaskType>::StrandPtr;
+
+    /// Concurrent queues are accessed without holding the sync mutex, the shared state must be atomic then
+    template<typename T>
+    using StateType = typename std::
+    conditional<std::is_same<SynchronizationTag, ConcurrentQueueTag>::value, std::atomic<T>, T>::type;
+
+    /**
+     * @brief Callable of a posted task which forwards escaping exceptions to the exception handler
+     *
+     * @tparam Callable Type of the wrapped callable
+     */
+    template<typename Callable>
+    class PostedTask {
+    public:
+        PostedTask(Callable&& callable, ThreadPool& thread_pool) :
+                m_callable{std::move(callable)}, m_thread_pool{thread_pool} {}
+
+        void operator()() {
+            try {
+                m_callable();
+            } catch (const TaskCancelled&) {
+                // Cancelled tasks end silently
+            } catch (...) {
+                m_thread_pool.get().handleException(std::current_exception());
+            }
+        }
+
+    private:
+        Callable m_callable;                               ///< Wrapped callable
+        std::reference_wrapper<ThreadPool> m_thread_pool;  ///< Pool which owns the exception handler
+    };
+
+    /**
+     * @brief Callable of a submitted task which publishes the result in the shared state of its future
+     *
+     * @tparam State Type of the shared state
+     * @tparam Callable Type of the wrapped callable
+     */
+    template<typename State, typename Callable>
+    class SubmittedTask {
+    public:
+        SubmittedTask(std::shared_ptr<State> state, Callable&& callable) :
+                m_state{std::move(state)}, m_callable{std::move(callable)} {}
+
+        SubmittedTask(SubmittedTask&&) = default;
+
+        /**
+         * @brief Publishes a broken promise if the task was dropped without running, e.g. by shutdownNow
+         */
+        ~SubmittedTask() {
+            if (m_state) {
+                m_state->setException(makeBrokenPromise());
+            }
+        }
+
+        void operator()() {
+            const auto state{std::move(m_state)};
+            fulfil(*state, m_callable);
+        }
+
+    private:
+        std::shared_ptr<State> m_state;  ///< Shared state which receives the result, nullptr once published
+        Callable m_callable;             ///< Wrapped callable
+    };
+
+    /**
+     * @brief Callable of an enqueued task which publishes the result in the std::promise of its future
+     *
+     * In contrast to std::packaged_task, the callable is stored in the task itself instead of in
+     * the shared state. A task which is dropped without running breaks the promise.
+     *
+     * @tparam R Type of the result
+     * @tparam Callable Type of the wrapped callable
+     */
+    template<typename R, typename Callable>
+    class PromisedTask {
+    public:
+        explicit PromisedTask(Callable&& callable) : m_callable{std::move(callable)} {}
+
+        std::future<R> getFuture() {
+            return m_promise.get_future();
+        }
+
+        void operator()() {
+            try {
+                publishResult(std::is_void<R>{});
+            } catch (...) {
+                m_promise.set_exception(std::current_exception());
+            }
+        }
+
+    private:
+        std::promise<R> m_promise{};  ///< Promise which receives the result
+        Callable m_callable;          ///< Wrapped callable
+
+        void publishResult(std::true_type /*returns_void*/) {
+            m_callable();
+            m_promise.set_value();
+        }
+
+        void publishResult(std::false_type /*returns_void*/) {
+            m_promise.set_value(m_callable());
+        }
+    };
+
+    /**
+     * @brief Waits for free slots on behalf of a producer whose push found the bounded queue full
+     *
+     * Workers execute a pending task themselves, otherwise all workers could end up waiting for
+     * each other. Other threads register as waiting producers and sleep until a worker frees a
+     * slot. The registration happens before the next push attempt, so a slot which is freed
+     * after that attempt is always noticed.
+     */
+    class SlotWaiter {
+    public:
+        SlotWaiter(ThreadPool& thread_pool, Deadline deadline) : m_thread_pool{thread_pool}, m_deadline{deadline} {}
+        SlotWaiter(const SlotWaiter&)            = delete;
+        SlotWaiter(SlotWaiter&&)                 = delete;
+        SlotWaiter& operator=(const SlotWaiter&) = delete;
+        SlotWaiter& operator=(SlotWaiter&&)      = delete;
+
+        ~SlotWaiter() {
+            if (m_is_registered) {
+                --m_thread_pool.m_waiting_producers;
+            }
+        }
+
+        /**
+         * @brief Makes progress until the next push attempt
+         *
+         * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index for other threads
+         *
+         * @returns True if the push should be retried, false if the deadline passed
+         */
+        bool wait(std::size_t worker_index) {
+            if (std::chrono::steady_clock::now() >= m_deadline) {
+                return false;
+            }
+
+            if (worker_index != no_worker_index) {
+                if (!m_thread_pool.tryExecuteTask()) {
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+
+            auto& thread_pool{m_thread_pool};
+            std::unique_lock<std::mutex> lock{thread_pool.m_producers_mtx};
+            if (!m_is_registered) {
+                ++thread_pool.m_waiting_producers;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_is_registered = true;
+                m_freed_slots   = thread_pool.m_freed_slots;
+                return true;
+            }
+
+            const auto epoch{m_freed_slots};
+            auto is_slot_freed{[&thread_pool, epoch]() { return thread_pool.m_freed_slots != epoch; }};
+            if (m_deadline == Deadline::max()) {
+                thread_pool.m_producers_cv.wait(lock, is_slot_freed);
+            } else if (!thread_pool.m_producers_cv.wait_until(lock, m_deadline, is_slot_freed)) {
+                return false;
+            }
+            m_freed_slots = thread_pool.m_freed_slots;
+            return true;
+        }
+
+    private:
+        ThreadPool& m_thread_pool;     ///< Pool which owns the bounded queue
+        Deadline m_deadline;           ///< Point in time after which the producer gives up
+        bool m_is_registered{false};   ///< Whether the producer is counted as waiting
+        std::size_t m_freed_slots{0};  ///< Epoch of freed slots which the last push attempt observed
+    };
+
+    /**
+     * @brief Callable of a pool task which executes a batch of tasks of a strand
+     *
+     * The task owns the strand. If tasks are left after the batch, it pushes a new drain task, so
+     * the strand is handed over to the next free worker instead of occupying this one.
+     */
+    class StrandTask {
+    public:
+        StrandTask(ThreadPool& thread_pool, StrandPtr strand) :
+                m_thread_pool{thread_pool}, m_strand{std::move(strand)} {}
+
+        void operator()() {
+            auto& thread_pool{m_thread_pool.get()};
+            while (!thread_pool.executeStrandTasks(m_strand)) {
+                try {
+                    thread_pool.pushTask(TaskType{StrandTask{thread_pool, m_strand}});
+                    return;
+                } catch (const std::runtime_error&) {
+                    if (thread_pool.m_is_aborted && thread_pool.currentWorkerIndex() != no_worker_index) {
+                        thread_pool.m_strands.discard(m_strand);
+                        return;
+                    }
+                    // The pool still drains its tasks or shutdownNow handed this task back, continue on this thread
+                }
+            }
+        }
+
+    private:
+        std::reference_wrapper<ThreadPool> m_thread_pool;  ///< Pool which executes the strand
+        StrandPtr m_strand;                                ///< The owned strand
+    };
+
+    /**
+     * @brief Task of a timer, shared between the timer wheel and the queued runs of the timer
+     */
+    struct ScheduledTask {
+        explicit ScheduledTask(TaskType&& scheduled_task) : task{std::move(scheduled_task)} {}
+
+        TaskType task;                          ///< Task which is executed by each run
+        std::atomic<bool> is_running{false};    ///< Whether a run executes, overlapping runs are skipped
+        std::atomic<bool> is_cancelled{false};  ///< Whether the timer was cancelled, queued runs are skipped
+    };
+
+    /**
+     * @brief Callable of a pool task which executes a due run of a timer
+     */
+    class TimerRun {
+    public:
+        explicit TimerRun(std::shared_ptr<ScheduledTask> scheduled_task) :
+                m_scheduled_task{std::move(scheduled_task)} {}
+
+        void operator()() {
+            auto& scheduled_task{*m_scheduled_task};
+            if (scheduled_task.is_cancelled || scheduled_task.is_running.exchange(true)) {
+                return;
+            }
+            scheduled_task.task();
+            scheduled_task.is_running = false;
+        }
+
+    private:
+        std::shared_ptr<ScheduledTask> m_scheduled_task;  ///< Timer which is due
+    };
+
+    /**
+     * @brief Tasks which a worker popped at once from a locked queue
+     *
+     * The worker claims the tasks one after another, shutdownNow claims the remaining ones when
+     * the pool is aborted. The buffer is only refilled while the sync mutex is locked.
+     */
+    struct alignas(cache_line_size) WorkerBatch {
+        std::vector<TaskType> tasks{};     ///< Popped tasks in queue order, executed tasks are empty
+        std::atomic<std::size_t> next{0};  ///< Index of the next unclaimed task
+    };
+
+    /// Batches of the workers, aligned by hand since std::allocator ignores alignas before C++17
+    using WorkerBatches = std::vector<WorkerBatch, CacheAlignedAllocator<WorkerBatch>>;
+
+    /**
+     * @brief Identifies the worker which is executed by the current thread
+     */
+    struct WorkerContext {
+        const ThreadPool* pool;  ///< Pool of the worker, nullptr for threads which are no workers
+        std::size_t index;       ///< Index of the worker within its pool
+    };
+
+    static constexpr std::size_t max_task_batch{32};    ///< Upper limit of tasks popped at once from a locked queue
+    static constexpr std::size_t max_strand_batch{32};  ///< Upper limit of strand tasks executed before a hand over
+
+    std::reference_wrapper<Sync> m_sync{};                            ///< Reference to used synchronization object
+    std::reference_wrapper<ThreadFactory> m_thread_factory;           ///< Creates workers, also after construction
+    const ElasticLimits m_limits;                                     ///< Bounds of the number of workers
+    QueueType m_tasks;                                                ///< Task queue which stores the pending tasks
+    WorkerBatches m_batches;                                          ///< Batch of each worker slot, locked queues only
+    const bool m_is_bounded;                                          ///< Whether producers may wait for free slots
+    InFlightCounter m_pending_pushes;                                 ///< Lock-free pushes in progress
+    std::mutex m_workers_mtx{};                                       ///< Guards the worker slots
+    std::vector<std::unique_ptr<ThreadJoinerType>> m_workers{};       ///< Worker slot per worker index
+    std::vector<bool> m_is_worker_running{};                          ///< Marks the slots with a running worker
+    std::atomic<std::size_t> m_running_workers{0};                    ///< Number of running workers
+    std::size_t m_live_workers{0};                                    ///< Worker threads which did not return yet
+    std::condition_variable m_workers_cv{};                           ///< Signals returning worker threads
+    std::atomic<bool> m_is_aborted{false};                            ///< Set by shutdownNow, hides the queued tasks
+    InFlightCounter m_tasks_in_flight;                                ///< Tasks which are queued or executed
+    std::mutex m_idle_mtx{};                                          ///< Guards the wakeup of idle waiters
+    std::condition_variable m_idle_cv{};                              ///< Signals that no task is in flight
+    StateType<bool> is_shutdown{false};                               ///< Boolean for internal shutdown state
+    std::function<void(std::exception_ptr)> m_exception_handler{};    ///< Handles exceptions of posted tasks
+    std::mutex m_controller_mtx{};                                    ///< Guards the hill climbing controller
+    HillClimbing m_controller;                                        ///< Chooses the worker target
+    std::atomic<std::size_t> m_worker_target;                         ///< Upper limit of workers chosen by controller
+    std::atomic<std::size_t> m_completed_tasks{0};                    ///< Tasks completed in the current sample
+    std::atomic<ClockRep> m_sample_start{now()};                      ///< Start of the current sample
+    ConcurrencyObserver m_concurrency_observer{};                     ///< Receives the controller decisions
+    std::mutex m_producers_mtx{};                                     ///< Guards the epoch of freed slots
+    std::condition_variable m_producers_cv{};                         ///< Wakes producers which wait for free slots
+    std::atomic<std::size_t> m_waiting_producers{0};                  ///< Number of producers which wait for free slots
+    std::size_t m_freed_slots{0};                                     ///< Epoch of slots freed for waiting producers
+    StrandRegistry<TaskType> m_strands{};                             ///< Strands with pending tasks
+    std::unique_ptr<TimerThreadType> m_timer_thread{};                ///< Services the timers, guarded by m_workers_mtx
+    std::mutex m_timers_mtx{};                                        ///< Guards the timers and the timer thread state
+    std::condition_variable m_timers_cv{};                            ///< Wakes the timer thread
+    const Deadline m_timers_epoch{std::chrono::steady_clock::now()};  ///< Point in time of timer tick zero
+    TimerWheel<std::shared_ptr<ScheduledTask>> m_timers{};            ///< Pending timers, a tick is one millisecond
+    std::uint64_t m_timer_wakeup_tick{0};                             ///< Tick until which the timer thread sleeps
+    bool m_is_timer_stopped{false};                                   ///< Set on shutdown, stops the timer thread
+
+    static const ElasticLimits& validate(const ElasticLimits& limits) {
+        if (limits.min_threads == 0 || limits.min_threads > limits.max_threads) {
+            throw std::invalid_argument{"Elastic thread pool requires 0 < min_threads <= max_threads."};
+        }
+        return limits;
+    }
+
+    bool isElastic() const {
+        return m_limits.min_threads != m_limits.max_threads;
+    }
+
+    bool isControlled() const {
+        return isElastic() && m_limits.control_interval.count() > 0;
+    }
+
+    static ClockRep now() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    /**
+     * @brief Creates the initial workers in the first slots
+     */
+    void startWorkers(std::size_t number_of_threads) {
+        std::lock_guard<std::mutex> lg{m_workers_mtx};
+        m_workers.resize(m_limits.max_threads);
+        m_is_worker_running.resize(m_limits.max_threads, false);
+        for (std::size_t current_thread{0}; current_thread < number_of_threads; ++current_thread) {
+            startWorker(current_thread);
+        }
+    }
+
+    /**
+     * @brief Creates a worker in a free slot
+     *
+     * A worker which retired from the slot before is joined first.
+     *
+     * @pre m_workers_mtx must be locked
+     *
+     * @param worker_index Index of the free slot
+     */
+    void startWorker(std::size_t worker_index) {
+        m_workers[worker_index].reset();
+        m_is_worker_running[worker_index] = true;
+        ++m_running_workers;
+        ++m_live_workers;
+        try {
+            auto worker_function = [this, worker_index]() { work(worker_index); };
+            m_workers[worker_index].reset(
+            new ThreadJoinerType{createWorkerThread(m_thread_factory.get(), worker_index, worker_function)});
+        } catch (...) {
+            m_is_worker_running[worker_index] = false;
+            --m_running_workers;
+            --m_live_workers;
+            throw;
+        }
+    }
+
+    /**
+     * @brief Adds a worker if the pushed tasks can't be picked up by an idle worker
+     *
+     * Parked workers were already notified by the push, so the pool only grows while all
+     * workers are busy or spinning.
+     *
+     * @param queued_tasks Number of queued tasks after the push
+     */
+    void growIfBacklogged(std::size_t queued_tasks) {
+        if (!isElastic() || queued_tasks < m_limits.backlog_threshold ||
+            m_running_workers.load() >= getWorkerTarget() || m_sync.get().getParkedThreads() != 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lg{m_workers_mtx};
+        bool is_pool_shut_down{false};
+        m_sync.get().executeLocked([&is_pool_shut_down, this]() { is_pool_shut_down = is_shutdown; });
+        if (is_pool_shut_down) {
+            return;
+        }
+
+        const auto free_slot{std::find(m_is_worker_running.begin(), m_is_worker_running.end(), false)};
+        if (m_running_workers.load() < getWorkerTarget() && free_slot != m_is_worker_running.end()) {
+            startWorker(static_cast<std::size_t>(free_slot - m_is_worker_running.begin()));
+        }
+    }
+
+    /**
+     * @brief Waits until work arrives, elastic pools give up after the keep alive duration
+     *
+     * @returns True if the predicate became true and the callable was called, false on timeout
+     */
+    template<typename Predicate, typename Callable>
+    bool waitForWork(Predicate& predicate, Callable& callable) {
+        if (!isElastic()) {
+            m_sync.get().waitThenExecute(predicate, callable);
+            return true;
+        }
+        return m_sync.get().waitForThenExecute(m_limits.keep_alive, predicate, callable);
+    }
+
+    /**
+     * @brief Retires an idle worker if the pool has more than the minimum number of workers
+     *
+     * The slot keeps the finished thread until a new worker takes it over or the pool is destroyed.
+     *
+     * @param worker_index Index of the calling worker
+     *
+     * @returns True if the worker has to finish, false if it keeps working
+     */
+    bool tryRetire(std::size_t worker_index) {
+        std::lock_guard<std::mutex> lg{m_workers_mtx};
+        if (m_running_workers.load() <= m_limits.min_threads) {
+            return false;
+        }
+
+        bool is_idle{false};
+        m_sync.get().executeLocked([&is_idle, this]() { is_idle = !is_shutdown && !hasWork(); });
+        if (!is_idle) {
+            return false;
+        }
+
+        m_is_worker_running[worker_index] = false;
+        --m_running_workers;
+        return true;
+    }
+
+    /**
+     * @brief Retires a worker while the pool has more workers than the controller's target
+     *
+     * Queued tasks are left to the remaining workers, which also steal from the retired slot.
+     *
+     * @param worker_index Index of the calling worker
+     *
+     * @returns True if the worker has to finish, false if it keeps working
+     */
+    bool tryRetireAboveTarget(std::size_t worker_index) {
+        if (!isControlled() || m_running_workers.load() <= m_worker_target.load()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lg{m_workers_mtx};
+        if (m_running_workers.load() <= m_worker_target.load()) {
+            return false;
+        }
+
+        m_is_worker_running[worker_index] = false;
+        --m_running_workers;
+        return true;
+    }
+
+    /**
+     * @brief Counts completed tasks and lets the hill climbing controller decide after each interval
+     *
+     * The worker which completes the first task after the interval takes the sample, others
+     * continue without waiting for the controller.
+     *
+     * @param number_of_tasks Number of tasks which were completed by the calling worker
+     */
+    void onTasksCompleted(std::size_t number_of_tasks) {
+        if (!isControlled()) {
+            return;
+        }
+
+        m_completed_tasks += number_of_tasks;
+        const auto sample_end{now()};
+        auto sample_start{m_sample_start.load()};
+        const std::chrono::steady_clock::duration elapsed{sample_end - sample_start};
+        if (elapsed < m_limits.control_interval) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> controller_lock{m_controller_mtx, std::try_to_lock};
+        if (!controller_lock.owns_lock() || !m_sample_start.compare_exchange_strong(sample_start, sample_end)) {
+            return;
+        }
+        const auto decision{m_controller.update(m_completed_tasks.exchange(0), elapsed)};
+        m_worker_target = decision.target;
+        controller_lock.unlock();
+
+        ConcurrencyObserver observer{};
+        m_sync.get().executeLocked([&observer, this]() { observer = m_concurrency_observer; });
+        if (observer) {
+            observer(decision);
+        }
+
+        bool has_work{false};
+        m_sync.get().executeLocked([&has_work, this]() { has_work = hasWork(); });
+        growIfBacklogged(has_work ? m_limits.backlog_threshold : 0);
+    }
+
+    /**
+     * @brief Worker function
+     *
+     * Each thread of the thread pool calls this function initially. The threads are either waiting
+     * in this function or processing the incoming tasks.
+     *
+     * @param worker_index Index of the calling worker
+     */
+    void work(std::size_t worker_index) {
+        currentWorker() = WorkerContext{this, worker_index};
+        work(worker_index, SynchronizationTag{});
+        currentWorker() = WorkerContext{nullptr, no_worker_index};
+
+        {
+            std::lock_guard<std::mutex> lg{m_workers_mtx};
+            --m_live_workers;
+        }
+        m_workers_cv.notify_all();
+    }
+
+    /**
+     * @brief Worker function for queues guarded by the sync mutex
+     *
+     * Tasks are only taken from the queue while the mutex is locked.
+     */
+    void work(std::size_t worker_index, LockedQueueTag) {
+        auto check_wait_condition{[this]() { return hasWork() || is_shutdown; }};
+        auto reserved_duration{std::chrono::steady_clock::duration::zero()};
+        auto execute_oldest_tasks{[this, worker_index, &reserved_duration](TaskLockType& lock) {
+            reserved_duration = executeOldestTasks(lock, worker_index);
+        }};
+
+        while (!is_shutdown || hasWork()) {
+            const bool has_worked{waitForWork(check_wait_condition, execute_oldest_tasks)};
+            if (reserved_duration != std::chrono::steady_clock::duration::zero()) {
+                waitForReservedTasks(worker_index, reserved_duration);
+                reserved_duration = std::chrono::steady_clock::duration::zero();
+            }
+            if (has_worked ? tryRetireAboveTarget(worker_index) : tryRetire(worker_index)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Parks a worker while all queued tasks are reserved for other workers
+     *
+     * The worker wakes up once the reservation expires, or earlier when a task it can take
+     * arrives or the queued tasks are gone.
+     *
+     * @param worker_index Index of the calling worker
+     * @param reserved_duration Remaining time until a reserved task becomes available
+     */
+    void waitForReservedTasks(std::size_t worker_index, std::chrono::steady_clock::duration reserved_duration) {
+        auto is_reservation_over{[this, worker_index]() {
+            return !hasWork() || reservedFor(m_tasks, worker_index) == std::chrono::steady_clock::duration::zero();
+        }};
+        m_sync.get().waitForThenExecute(reserved_duration, is_reservation_over, [](TaskLockType&) {});
+    }
+
+    /**
+     * @brief Worker function for concurrent queues
+     *
+     * Tasks are taken from the queue without locking the mutex. The sync object is only used
+     * to park the worker while no task is available.
+     */
+    void work(std::size_t worker_index, ConcurrentQueueTag) {
+        auto check_wait_condition{[this]() { return hasWork() || is_shutdown; }};
+        bool running{true};
+        auto check_running{[this, &running](TaskLockType&) { running = !isDrained(); }};
+
+        while (running) {
+            TaskType task{};
+            if (!m_is_aborted && m_tasks.tryPop(task, worker_index)) {
+                notifyProducers();
+                task();
+                finishTasks(1);
+                onTasksCompleted(1);
+                if (tryRetireAboveTarget(worker_index)) {
+                    return;
+                }
+                continue;
+            }
+
+            if (!waitForWork(check_wait_condition, check_running) && tryRetire(worker_index)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes a task into the queue and notifies a worker
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    void pushTask(TaskType&& task) {
+        pushTasks(&task, &task + 1);
+    }
+
+    /**
+     * @brief Pushes a task into the level of its priority and notifies a worker
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    void pushTaskWithPriority(TaskType&& task, Priority priority) {
+        pushTasks(
+        &task,
+        &task + 1,
+        [this, priority](TaskType* first_task, TaskType* last_task, std::size_t worker_index) {
+            return m_tasks.push(first_task, last_task, worker_index, priority);
+        },
+        Deadline::max(),
+        SynchronizationTag{});
+    }
+
+    /**
+     * @brief Pushes a task into the queue of a NUMA node and notifies a worker
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::out_of_range is thrown when the node is not available
+     */
+    void pushTaskToNode(TaskType&& task, std::size_t node) {
+        pushTasks(
+        &task,
+        &task + 1,
+        [this, node](TaskType* first_task, TaskType* last_task, std::size_t) {
+            return m_tasks.pushToNode(first_task, last_task, node);
+        },
+        Deadline::max(),
+        SynchronizationTag{});
+    }
+
+    /**
+     * @brief Pushes a task to its strand and schedules the strand if it was idle
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    void pushTaskToStrand(TaskType&& task, StrandKey key) {
+        auto strand{m_strands.push(key, std::move(task))};
+        if (!strand) {
+            return;
+        }
+
+        try {
+            pushTask(TaskType{StrandTask{*this, strand}});
+        } catch (...) {
+            // Tasks which other producers pushed meanwhile are dropped as well, their futures report a broken promise
+            m_strands.discard(strand);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Executes a batch of tasks of an owned strand
+     *
+     * @returns True if the strand became idle, false if tasks are left and the strand is still owned
+     */
+    bool executeStrandTasks(const StrandPtr& strand) {
+        std::size_t number_of_tasks{0};
+        do {
+            auto task{strand->pop()};
+            task();
+            ++number_of_tasks;
+        } while (number_of_tasks < max_strand_batch && strand->hasMoreTasks(number_of_tasks));
+        return m_strands.release(strand, number_of_tasks);
+    }
+
+    /**
+     * @brief Adds a timer and wakes the timer thread if the timer is due before its wakeup
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    TimerId addTimer(std::uint64_t due_tick, std::uint64_t period, TaskType&& task) {
+        TimerId id{};
+        {
+            std::lock_guard<std::mutex> lg{m_timers_mtx};
+            if (m_is_timer_stopped) {
+                throw std::runtime_error{"Thread pool already shut down, enqueuing failed."};
+            }
+            id = m_timers.add(due_tick, period, std::make_shared<ScheduledTask>(std::move(task)));
+            if (due_tick < m_timer_wakeup_tick) {
+                m_timer_wakeup_tick = due_tick;
+                m_timers_cv.notify_one();
+            }
+        }
+
+        // Started for accepted timers only, the thread services the timer once it runs
+        try {
+            startTimerThread();
+        } catch (...) {
+            std::lock_guard<std::mutex> lg{m_timers_mtx};
+            m_timers.cancel(id);
+            throw;
+        }
+        return id;
+    }
+
+    void startTimerThread() {
+        std::lock_guard<std::mutex> lg{m_workers_mtx};
+        bool is_timer_stopped{false};
+        {
+            std::lock_guard<std::mutex> timers_lg{m_timers_mtx};
+            is_timer_stopped = m_is_timer_stopped;
+        }
+        if (!m_timer_thread && !is_timer_stopped) {
+            // The thread factory would pin the timer thread like a worker
+            m_timer_thread.reset(new TimerThreadType{std::thread{[this]() { serviceTimers(); }}});
+        }
+    }
+
+    void stopTimers() {
+        {
+            std::lock_guard<std::mutex> lg{m_timers_mtx};
+            m_is_timer_stopped = true;
+        }
+        m_timers_cv.notify_all();
+    }
+
+    /**
+     * @brief Function of the timer thread, pushes due timers into the task queue until shutdown
+     */
+    void serviceTimers() {
+        std::vector<TaskType> due_tasks{};
+        std::unique_lock<std::mutex> lock{m_timers_mtx};
+        while (!m_is_timer_stopped) {
+            m_timers.advance(currentTimerTick(), [&due_tasks](const std::shared_ptr<ScheduledTask>& scheduled_task) {
+                due_tasks.emplace_back(TimerRun{scheduled_task});
+            });
+
+            if (!due_tasks.empty()) {
+                // Pushing can block on a bounded queue, timers are added meanwhile
+                lock.unlock();
+                try {
+                    pushTasks(due_tasks.data(), due_tasks.data() + due_tasks.size());
+                } catch (const std::runtime_error&) {
+                    return;
+                }
+                due_tasks.clear();
+                lock.lock();
+                continue;
+            }
+
+            m_timer_wakeup_tick = m_timers.nextExpiry();
+            if (m_timer_wakeup_tick == std::numeric_limits<std::uint64_t>::max()) {
+                m_timers_cv.wait(lock);
+            } else {
+                m_timers_cv.wait_until(lock, m_timers_epoch + std::chrono::milliseconds{m_timer_wakeup_tick});
+            }
+        }
+    }
+
+    /// Tick of a point in time, rounded up so timers never fire early
+    std::uint64_t toTimerTick(Deadline time) const {
+        if (time <= m_timers_epoch) {
+            return 0;
+        }
+        const auto elapsed{time - m_timers_epoch};
+        const auto ticks{std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)};
+        return static_cast<std::uint64_t>(ticks.count()) + (ticks < elapsed ? 1 : 0);
+    }
+
+    /// Tick of the current point in time, rounded down
+    std::uint64_t currentTimerTick() const {
+        const auto elapsed{std::chrono::steady_clock::now() - m_timers_epoch};
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    }
+
+    /**
+     * @brief Takes all tasks out of a queue guarded by the sync mutex
+     *
+     * The not yet started tasks of the worker batches are taken as well, the workers stop
+     * claiming them once the pool is aborted.
+     *
+     * @returns The taken tasks, the batches first and then in queue order
+     */
+    std::vector<TaskType> takeQueuedTasks(LockedQueueTag) {
+        const auto worker_index{currentWorkerIndex()};
+        std::vector<TaskType> tasks{};
+        m_sync.get().executeLocked([&tasks, this]() {
+            for (auto& batch : m_batches) {
+                const auto batch_size{batch.tasks.size()};
+                for (auto index{std::min(batch.next.exchange(batch_size), batch_size)}; index < batch_size; ++index) {
+                    tasks.push_back(std::move(batch.tasks[index]));
+                }
+            }
+        });
+
+        bool has_tasks{true};
+        while (has_tasks) {
+            m_sync.get().executeLocked([&tasks, &has_tasks, worker_index, this]() {
+                TaskType task{};
+                while (m_tasks.tryPop(task, worker_index)) {
+                    tasks.push_back(std::move(task));
+                }
+                has_tasks = !m_tasks.empty();
+            });
+            if (has_tasks) {
+                // Queued tasks may be reserved for another worker for a short time
+                std::this_thread::yield();
+            }
+        }
+        return tasks;
+    }
+
+    /**
+     * @brief Takes all tasks out of a concurrent queue, including the tasks of pushes in progress
+     *
+     * @returns The taken tasks in queue order
+     */
+    std::vector<TaskType> takeQueuedTasks(ConcurrentQueueTag) {
+        const auto worker_index{currentWorkerIndex()};
+        std::vector<TaskType> tasks{};
+        TaskType task{};
+        while (!m_pending_pushes.isZero() || !m_tasks.empty()) {
+            if (m_tasks.tryPop(task, worker_index)) {
+                tasks.push_back(std::move(task));
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        return tasks;
+    }
+
+    /**
+     * @brief Pushes tasks into the queue and notifies workers
+     *
+     * @param deadline Point in time after which the producer stops waiting for free slots in a
+     *                 bounded queue, Deadline::max() waits until all tasks are pushed
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns The first task which was not pushed, last if all tasks were pushed
+     */
+    TaskType* pushTasks(TaskType* first, TaskType* last, Deadline deadline = Deadline::max()) {
+        return pushTasks(
+        first,
+        last,
+        [this](TaskType* first_task, TaskType* last_task, std::size_t worker_index) {
+            return m_tasks.push(first_task, last_task, worker_index);
+        },
+        deadline,
+        SynchronizationTag{});
+    }
+
+    /**
+     * @brief Pushes a task with a future into the queue unless the deadline passes first
+     *
+     * @returns The future of the task, an invalid future if the task wasn't pushed
+     */
+    template<typename R, typename Callable>
+    std::future<R> pushTaskUntil(PromisedTask<R, Callable>&& promised_task, Deadline deadline) {
+        auto future{promised_task.getFuture()};
+        TaskType task{std::move(promised_task)};
+        if (pushTasks(&task, &task + 1, deadline) != &task + 1) {
+            return std::future<R>{};
+        }
+        return future;
+    }
+
+    /**
+     * @brief Pushes tasks into a queue guarded by the sync mutex and notifies workers
+     *
+     * All tasks which fit into the queue are pushed within a single critical section.
+     *
+     * @tparam Push Callable type which pushes a task range to the queue
+     *
+     * @param push Callable which receives the task range and the index of the calling worker and
+     *             returns the first task which was not pushed
+     * @param deadline Point in time after which the producer stops waiting for free slots
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns The first task which was not pushed, last if all tasks were pushed
+     */
+    template<typename Push>
+    TaskType* pushTasks(TaskType* first, TaskType* last, Push push, Deadline deadline, LockedQueueTag) {
+        const auto worker_index{currentWorkerIndex()};
+        SlotWaiter slot_waiter{*this, deadline};
+
+        m_tasks_in_flight.start(worker_index, static_cast<std::size_t>(last - first));
+        try {
+            while (true) {
+                TaskType* not_pushed{first};
+                std::size_t queued_tasks{0};
+                m_sync.get().executeLocked([first, last, worker_index, &push, &not_pushed, &queued_tasks, this]() {
+                    throwWhenPoolIsShutDown();
+                    not_pushed   = push(first, last, worker_index);
+                    queued_tasks = m_tasks.size();
+                });
+                if (not_pushed != first) {
+                    notifyWorkers(static_cast<std::size_t>(not_pushed - first));
+                    growIfBacklogged(queued_tasks);
+                }
+
+                first = not_pushed;
+                if (first == last || !slot_waiter.wait(worker_index)) {
+                    break;
+                }
+            }
+        } catch (...) {
+            finishTasks(static_cast<std::size_t>(last - first));
+            throw;
+        }
+        finishTasks(static_cast<std::size_t>(last - first));
+        return first;
+    }
+
+    /**
+     * @brief Pushes tasks into a concurrent queue and notifies workers
+     *
+     * The pending push counter keeps the workers alive until every push which started before
+     * the shutdown was signaled has finished.
+     *
+     * @tparam Push Callable type which pushes a task range to the queue
+     *
+     * @param push Callable which receives the task range and the index of the calling worker and
+     *             returns the first task which was not pushed
+     * @param deadline Point in time after which the producer stops waiting for free slots
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns The first task which was not pushed, last if all tasks were pushed
+     */
+    template<typename Push>
+    TaskType* pushTasks(TaskType* first, TaskType* last, Push push, Deadline deadline, ConcurrentQueueTag) {
+        const auto worker_index{currentWorkerIndex()};
+        SlotWaiter slot_waiter{*this, deadline};
+
+        m_pending_pushes.start(worker_index, 1);
+        m_tasks_in_flight.start(worker_index, static_cast<std::size_t>(last - first));
+        try {
+            while (true) {
+                throwWhenPoolIsShutDown();
+                auto* const not_pushed{push(first, last, worker_index)};
+                notifyAfterPush(static_cast<std::size_t>(not_pushed - first));
+
+                first = not_pushed;
+                if (first == last || !slot_waiter.wait(worker_index)) {
+                    break;
+                }
+            }
+        } catch (...) {
+            finishTasks(static_cast<std::size_t>(last - first));
+            m_pending_pushes.finish(worker_index, 1);
+            throw;
+        }
+        finishTasks(static_cast<std::size_t>(last - first));
+        m_pending_pushes.finish(worker_index, 1);
+        if (isElastic()) {
+            growIfBacklogged(hasWork() ? 1 : 0);
+        }
+        return first;
+    }
+
+    /**
+     * @brief Removes tasks from the in-flight count and wakes the idle waiters once it drops to zero
+     *
+     * Tasks are counted before they are pushed, so the count can't drop to zero while a worker
+     * executes a task which it popped right after the push. The count is only summed up while a
+     * thread waits in waitIdle, otherwise each thread just updates its own stripe.
+     *
+     * @param number_of_tasks Number of tasks which were executed, dropped or not pushed
+     */
+    void finishTasks(std::size_t number_of_tasks) {
+        if (number_of_tasks == 0 || !m_tasks_in_flight.finish(currentWorkerIndex(), number_of_tasks) ||
+            !m_tasks_in_flight.isZero()) {
+            return;
+        }
+
+        // Waiters check the count while holding the mutex, passing it ensures that the wakeup can't get lost
+        {
+            std::lock_guard<std::mutex> lg{m_idle_mtx};
+        }
+        m_idle_cv.notify_all();
+    }
+
+    /**
+     * @brief Notifies workers about tasks which were pushed without holding the sync mutex
+     *
+     * @param number_of_tasks Number of tasks which were pushed
+     */
+    void notifyAfterPush(std::size_t number_of_tasks) {
+        if (number_of_tasks == 0) {
+            return;
+        }
+
+        // Eventcount handshake with parking workers, which count themselves as parked and re-check
+        // the queue after a fence. Either they see the pushed tasks or this check sees them.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sync.get().getParkedThreads() != 0) {
+            // A parked worker may still be between its check and its wait, it holds the mutex until
+            // it waits, so passing the mutex once ensures that the notification can't get lost
+            m_sync.get().executeLocked([]() {});
+        }
+        notifyWorkers(number_of_tasks);
+    }
+
+    /**
+     * @brief Wakes up enough workers to process new tasks
+     *
+     * @param number_of_tasks Number of tasks which were pushed
+     */
+    void notifyWorkers(std::size_t number_of_tasks) {
+        if (number_of_tasks >= m_running_workers.load()) {
+            m_sync.get().notifyAll();
+            return;
+        }
+
+        for (; number_of_tasks > 0; --number_of_tasks) {
+            m_sync.get().notifyOne();
+        }
+    }
+
+    template<typename Callable>
+    PostedTask<Callable> makePostedTask(Callable&& callable) {
+        return PostedTask<Callable>{std::move(callable), *this};
+    }
+
+    template<typename R, typename Callable>
+    static PromisedTask<R, Callable> makePromisedTask(Callable&& callable) {
+        return PromisedTask<R, Callable>{std::move(callable)};
+    }
+
+    /**
+     * @brief Passes an exception of a posted task to the exception handler
+     *
+     * @param exception The exception which escaped the task
+     */
+    void handleException(std::exception_ptr exception) {
+        std::function<void(std::exception_ptr)> exception_handler{};
+        m_sync.get().executeLocked([&exception_handler, this]() { exception_handler = m_exception_handler; });
+
+        if (!exception_handler) {
+            std::terminate();
+        }
+        exception_handler(exception);
+    }
+
+    /**
+     * @brief Schedules the continuation of a future on the pool
+     *
+     * @param thread_pool The pool which produced the result
+     * @param continuation The continuation, which runs on the calling thread if the pool is shut down
+     */
+    static void scheduleContinuation(void* thread_pool, Task&& continuation) {
+        try {
+            static_cast<ThreadPool*>(thread_pool)->pushTask(std::move(continuation));
+        } catch (const std::runtime_error&) {
+            continuation();
+        }
+    }
+
+    bool tryPopTask(TaskType& task, LockedQueueTag) {
+        if (m_is_aborted) {
+            return false;
+        }
+
+        bool popped{false};
+        m_sync.get().executeLocked([&task, &popped, this]() { popped = m_tasks.tryPop(task, currentWorkerIndex()); });
+        if (popped) {
+            notifyProducers();
+        }
+        return popped;
+    }
+
+    bool tryPopTask(TaskType& task, ConcurrentQueueTag) {
+        if (m_is_aborted || !m_tasks.tryPop(task, currentWorkerIndex())) {
+            return false;
+        }
+
+        notifyProducers();
+        return true;
+    }
+
+    /**
+     * @brief Wakes producers which wait for free slots after tasks were taken from the queue
+     */
+    void notifyProducers() {
+        // Producers of unbounded queues never wait, so the hot path skips the fence
+        if (!m_is_bounded) {
+            return;
+        }
+
+        // Pairs with the fence of registering producers, either their next push sees the free slot
+        // or this check sees their registration
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_producers.load(std::memory_order_relaxed) != 0) {
+            wakeProducers();
+        }
+    }
+
+    /**
+     * @brief Wakes all producers which wait for free slots, they retry their push afterwards
+     */
+    void wakeProducers() {
+        {
+            std::lock_guard<std::mutex> lg{m_producers_mtx};
+            ++m_freed_slots;
+        }
+        m_producers_cv.notify_all();
+    }
+
+    /**
+     * @brief Checks if thread pool has work to do
+     *
+     * @returns True if tasks are queued, false otherwise or if the queued tasks are taken by shutdownNow
+     */
+    bool hasWork() {
+        return !m_is_aborted && !m_tasks.empty();
+    }
+
+    /**
+     * @brief Checks if the workers are allowed to finish
+     *
+     * @returns True if the pool is shut down and all tasks are processed, false otherwise
+     */
+    bool isDrained() {
+        return is_shutdown && m_pending_pushes.isZero() && !hasWork();
+    }
+
+    /**
+     * @brief Executes the oldest tasks from the task queue
+     *
+     * This function either executes and removes a batch of the oldest tasks in the queue or
+     * finishes directly when no task is remaining. The lock is unlocked before the task functions
+     * are executed to allow other tasks executions in parallel.
+     *
+     * @pre taskQueueLock must be already locked when function is executed
+     *
+     * @param taskQueueLock A unique lock which protectes the queue
+     * @param worker_index Index of the calling worker
+     *
+     * @returns Zero if tasks were executed or none is queued, the time until one of the queued
+     *          tasks becomes available when all of them are reserved for other workers
+     */
+    std::chrono::steady_clock::duration executeOldestTasks(TaskLockType& taskQueueLock, std::size_t worker_index) {
+        if (!hasWork()) {
+            return std::chrono::steady_clock::duration::zero();
+        }
+
+        auto& batch{m_batches[worker_index]};
+        popOldestTasksFromQueue(batch, worker_index);
+        if (batch.tasks.empty()) {
+            // Queued tasks may be reserved for another worker for a short time, like the slots of
+            // pool_party::detail::LifoSlotQueue
+            const auto reserved_duration{reservedFor(m_tasks, worker_index)};
+            taskQueueLock.unlock();
+            return reserved_duration;
+        }
+
+        taskQueueLock.unlock();
+
+        notifyProducers();
+        std::size_t executed_tasks{0};
+        while (!m_is_aborted) {
+            const auto index{batch.next++};
+            if (index >= batch.tasks.size()) {
+                break;
+            }
+            batch.tasks[index]();
+            batch.tasks[index] = TaskType{};
+            ++executed_tasks;
+        }
+        finishTasks(executed_tasks);
+        onTasksCompleted(executed_tasks);
+        return std::chrono::steady_clock::duration::zero();
+    }
+
+    /**
+     * @brief Gets and removes a batch of the oldest tasks from the queue
+     *
+     * Each worker takes its share of the queued tasks, but at most max_task_batch and the limit of
+     * the queue, see pool_party::detail::MaxPopBatch. Deep queues are drained with a fraction of
+     * the lock acquisitions, while shallow queues are still spread over all workers.
+     *
+     * @pre This function must be used in critical section
+     *
+     * @param batch Batch of the worker, receives the oldest tasks in queue order
+     * @param worker_index Index of the calling worker
+     */
+    void popOldestTasksFromQueue(WorkerBatch& batch, std::size_t worker_index) {
+        const auto worker_share{m_tasks.size() / std::max<std::size_t>(m_running_workers.load(), 1)};
+        const auto batch_limit{std::min(max_task_batch, MaxPopBatch<QueueType>::value)};
+        const auto batch_size{std::min(std::max<std::size_t>(worker_share, 1), batch_limit)};
+
+        batch.tasks.clear();
+        batch.tasks.reserve(batch_limit);
+        TaskType task{};
+        while (batch.tasks.size() < batch_size && m_tasks.tryPop(task, worker_index)) {
+            batch.tasks.push_back(std::move(task));
+        }
+        batch.next = 0;
+    }
+
+    /**
+     * @brief Context of the worker which is executed by the current thread
+     *
+     * @returns Reference to the thread local worker context
+     */
+    static WorkerContext& currentWorker() {
+        static thread_local WorkerContext context{nullptr, no_worker_index};
+        return context;
+    }
+
+    /**
+     * @brief Index of the worker which is executed by the current thread
+     *
+     * @returns Worker index, pool_party::detail::no_worker_index if the thread is no worker of this pool
+     */
+    std::size_t currentWorkerIndex() const {
+        const auto& context{currentWorker()};
+        return context.pool == this ? context.index : no_worker_index;
+    }
+
+    /**
+     * @brief Throws exception when shutdown state is set
+     *
+     * @pre This function must be used in critical section
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down and the
+     * client is trying to enqueue tasks
+     *
+     * @see pool_party::detail::ThreadPool::enqueue
+     */
+    void throwWhenPoolIsShutDown() {
+        if (is_shutdown) {
+            throw std::runtime_error{"Thread pool already shut down, enqueuing failed."};
+        }
+    }
+};
+
+template<typename ThreadFactory, typename Sync, template<typename> class Queue>
+constexpr std::size_t ThreadPool<ThreadFactory, Sync, Queue>::max_task_batch;
+
+template<typename ThreadFactory, typename Sync, template<typename> class Queue>
+constexpr std::size_t ThreadPool<ThreadFactory, Sync, Queue>::max_strand_batch;
 
 }  // namespace detail
 }  // namespace pool_party
@@ -0,0 +1,367 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_TIMER_WHEEL_HPP_
+#define POOL_PARTY_DETAIL_TIMER_WHEEL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Handle of a timer, used to cancel it
+ *
+ * Handles of fired or cancelled timers stay safe to use, the storage of a timer is reused with a
+ * new generation.
+ */
+struct TimerId {
+    /**
+     * @brief Constructor of a handle which refers to no timer
+     */
+    TimerId() = default;
+
+    /**
+     * @brief Constructor of TimerId
+     *
+     * @param timer_index Index of the timer storage
+     * @param timer_generation Generation of the timer storage
+     */
+    TimerId(std::size_t timer_index, std::uint64_t timer_generation) :
+            index{timer_index}, generation{timer_generation} {}
+
+    std::size_t index{0};         ///< Index of the timer storage
+    std::uint64_t generation{0};  ///< Generation of the timer storage, zero is never used
+};
+
+/**
+ * @brief Hierarchical timer wheel
+ *
+ * Implementation of the hierarchical timing wheel by Varghese and Lauck. Each level has 64 slots,
+ * a slot of level n spans 64^n ticks. A timer is placed in the lowest level whose current
+ * rotation contains its due tick, when time reaches the slot of a higher level its timers
+ * cascade into lower levels. Adding and cancelling a timer takes constant time, the timers of a
+ * slot are kept in an intrusive list. Due ticks beyond the range of the wheel are placed in its
+ * last slot and cascade until they are in range.
+ *
+ * The wheel is not thread safe, time is given in abstract ticks by the caller.
+ *
+ * @tparam T Type of the item of a timer, must be movable
+ */
+template<typename T>
+class TimerWheel {
+public:
+    static constexpr std::size_t slot_bits{6};                      ///< Number of tick bits per level
+    static constexpr std::size_t slots_per_level{1U << slot_bits};  ///< Number of slots per level
+    static constexpr std::size_t number_of_levels{6};               ///< Number of levels, 64^6 ticks in total
+
+    /**
+     * @brief Constructor of an empty TimerWheel
+     *
+     * @param current_tick Tick which is processed by the next advance
+     */
+    explicit TimerWheel(std::uint64_t current_tick = 0) : m_current_tick{current_tick} {
+        m_slots.fill(no_timer);
+        m_occupied_slots.fill(0);
+    }
+
+    /**
+     * @brief Adds a timer
+     *
+     * @param due_tick Tick at which the timer fires, timers which are already due fire at the next processed tick
+     * @param period Number of ticks after which a fired timer fires again, zero fires only once
+     * @param item Item which is passed to the callback of advance when the timer fires
+     *
+     * @returns Handle of the timer
+     */
+    TimerId add(std::uint64_t due_tick, std::uint64_t period, T&& item) {
+        std::size_t index{0};
+        if (m_free_timers.empty()) {
+            index = m_timers.size();
+            m_timers.emplace_back();
+        } else {
+            index = m_free_timers.back();
+            m_free_timers.pop_back();
+        }
+
+        auto& timer{m_timers[index]};
+        timer.item     = std::move(item);
+        timer.due_tick = std::max(due_tick, m_current_tick);
+        timer.period   = period;
+        timer.is_used  = true;
+        place(index);
+        ++m_size;
+        return TimerId{index, timer.generation};
+    }
+
+    /**
+     * @brief Cancels a timer which did not fire yet or fires periodically
+     *
+     * @param id Handle of the timer
+     *
+     * @returns True if the timer was cancelled, false if it already fired or was cancelled before
+     */
+    bool cancel(TimerId id) {
+        if (find(id) == nullptr) {
+            return false;
+        }
+        unlink(id.index);
+        release(id.index);
+        return true;
+    }
+
+    /**
+     * @brief Looks up the item of a pending timer
+     *
+     * @param id Handle of the timer
+     *
+     * @returns Pointer to the item, nullptr if the timer already fired or was cancelled
+     */
+    T* find(TimerId id) {
+        if (id.index >= m_timers.size() || !m_timers[id.index].is_used ||
+            m_timers[id.index].generation != id.generation) {
+            return nullptr;
+        }
+        return &m_timers[id.index].item;
+    }
+
+    /**
+     * @brief Fires all timers which are due up to the given tick
+     *
+     * Ticks without timers are skipped. Periodic timers are placed again after they fired, periods
+     * which are missed up to the given tick are skipped.
+     *
+     * @tparam Callback Type of the callback
+     *
+     * @param now Last tick to process
+     * @param on_due Called with a reference to the item of each fired timer, in order of the due ticks
+     */
+    template<typename Callback>
+    void advance(std::uint64_t now, Callback&& on_due) {
+        while (m_current_tick <= now) {
+            const auto next_tick{nextExpiry()};
+            if (next_tick > now) {
+                m_current_tick = now + 1;
+                return;
+            }
+            m_current_tick = std::max(m_current_tick, next_tick);
+            cascade();
+            auto deferred{fire(now, on_due)};
+            ++m_current_tick;
+
+            // Timers beyond the range reached the last tick of the rotation, the next rotation may contain them
+            while (deferred != no_timer) {
+                const auto next{m_timers[deferred].next};
+                place(deferred);
+                deferred = next;
+            }
+        }
+    }
+
+    /**
+     * @brief Lower bound of the tick at which the next timer fires or cascades
+     *
+     * @returns The tick, std::numeric_limits<std::uint64_t>::max() if no timer is pending
+     */
+    std::uint64_t nextExpiry() const {
+        auto next_tick{std::numeric_limits<std::uint64_t>::max()};
+        for (std::size_t level{0}; level < number_of_levels; ++level) {
+            const auto shift{level * slot_bits};
+            const auto current_slot{slotOf(m_current_tick, level)};
+            const auto occupied_ahead{m_occupied_slots[level] >> current_slot};
+            if (occupied_ahead == 0) {
+                continue;
+            }
+
+            std::size_t slot{current_slot};
+            for (auto occupied{occupied_ahead}; (occupied & 1U) == 0; occupied >>= 1U) {
+                ++slot;
+            }
+            const auto rotation_start{m_current_tick & ~((std::uint64_t{1} << (shift + slot_bits)) - 1)};
+            const auto slot_start{rotation_start | (static_cast<std::uint64_t>(slot) << shift)};
+            next_tick = std::min(next_tick, std::max(slot_start, m_current_tick));
+        }
+        return next_tick;
+    }
+
+    /**
+     * @brief Number of pending timers
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Checks if no timer is pending
+     */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+private:
+    static constexpr std::size_t no_timer{std::numeric_limits<std::size_t>::max()};  ///< End of a slot list
+
+    /**
+     * @brief Storage of a timer, linked into the list of its slot while pending
+     */
+    struct Timer {
+        T item{};                        ///< Item which is passed to the callback
+        std::uint64_t due_tick{0};       ///< Tick at which the timer fires
+        std::uint64_t period{0};         ///< Ticks between periodic firings, zero for one-shot timers
+        std::uint64_t generation{1};     ///< Generation of the storage, advanced when the storage is released
+        std::size_t slot{0};             ///< Slot whose list contains the timer
+        std::size_t previous{no_timer};  ///< Previous timer of the slot list
+        std::size_t next{no_timer};      ///< Next timer of the slot list
+        bool is_used{false};             ///< Whether the storage holds a pending timer
+    };
+
+    std::vector<Timer> m_timers{};                                          ///< Storage of all timers
+    std::vector<std::size_t> m_free_timers{};                               ///< Indices of unused storage
+    std::array<std::size_t, number_of_levels * slots_per_level> m_slots{};  ///< Head of the list of each slot
+    std::array<std::uint64_t, number_of_levels> m_occupied_slots{};         ///< Bitmap of the non-empty slots per level
+    std::uint64_t m_current_tick;                                           ///< Next tick to process
+    std::size_t m_size{0};                                                  ///< Number of pending timers
+
+    static std::size_t slotOf(std::uint64_t tick, std::size_t level) {
+        return static_cast<std::size_t>(tick >> (level * slot_bits)) & (slots_per_level - 1);
+    }
+
+    /// Places a timer in the lowest level whose current rotation contains its due tick
+    void place(std::size_t index) {
+        constexpr auto range_bits{number_of_levels * slot_bits};
+        auto& timer{m_timers[index]};
+        const auto last_tick_in_range{m_current_tick | ((std::uint64_t{1} << range_bits) - 1)};
+        const auto tick{std::min(timer.due_tick, last_tick_in_range)};
+
+        std::size_t level{0};
+        for (auto differing_bits{(tick ^ m_current_tick) >> slot_bits}; differing_bits != 0;
+             differing_bits >>= slot_bits) {
+            ++level;
+        }
+
+        const auto slot_in_level{slotOf(tick, level)};
+        timer.slot     = level * slots_per_level + slot_in_level;
+        timer.previous = no_timer;
+        timer.next     = m_slots[timer.slot];
+        if (timer.next != no_timer) {
+            m_timers[timer.next].previous = index;
+        }
+        m_slots[timer.slot] = index;
+        m_occupied_slots[level] |= std::uint64_t{1} << slot_in_level;
+    }
+
+    void unlink(std::size_t index) {
+        auto& timer{m_timers[index]};
+        if (timer.previous != no_timer) {
+            m_timers[timer.previous].next = timer.next;
+        } else {
+            m_slots[timer.slot] = timer.next;
+        }
+        if (timer.next != no_timer) {
+            m_timers[timer.next].previous = timer.previous;
+        }
+        if (m_slots[timer.slot] == no_timer) {
+            m_occupied_slots[timer.slot / slots_per_level] &= ~(std::uint64_t{1} << (timer.slot % slots_per_level));
+        }
+    }
+
+    void release(std::size_t index) {
+        auto& timer{m_timers[index]};
+        timer.item    = T{};
+        timer.is_used = false;
+        ++timer.generation;
+        m_free_timers.push_back(index);
+        --m_size;
+    }
+
+    /// Detaches the list of a slot and returns its first timer
+    std::size_t detach(std::size_t slot) {
+        const auto first{m_slots[slot]};
+        m_slots[slot] = no_timer;
+        m_occupied_slots[slot / slots_per_level] &= ~(std::uint64_t{1} << (slot % slots_per_level));
+        return first;
+    }
+
+    /// Moves the timers of the higher level slots which start at the current tick into lower levels
+    void cascade() {
+        for (std::size_t level{number_of_levels - 1}; level > 0; --level) {
+            if ((m_current_tick & ((std::uint64_t{1} << (level * slot_bits)) - 1)) != 0) {
+                continue;
+            }
+            for (auto index{detach(level * slots_per_level + slotOf(m_current_tick, level))}; index != no_timer;) {
+                const auto next{m_timers[index].next};
+                place(index);
+                index = next;
+            }
+        }
+    }
+
+    /// Fires the timers of the current tick and returns the list of timers which are not due yet
+    template<typename Callback>
+    std::size_t fire(std::uint64_t now, Callback& on_due) {
+        std::size_t deferred{no_timer};
+        for (auto index{detach(slotOf(m_current_tick, 0))}; index != no_timer;) {
+            const auto next{m_timers[index].next};
+            auto& timer{m_timers[index]};
+            if (timer.due_tick > m_current_tick) {
+                timer.next = deferred;
+                deferred   = index;
+                index      = next;
+                continue;
+            }
+
+            on_due(timer.item);
+            if (timer.period == 0) {
+                release(index);
+            } else {
+                // Keep the phase of the timer, but skip the periods which are already missed
+                timer.due_tick += ((std::max(now, timer.due_tick) - timer.due_tick) / timer.period + 1) * timer.period;
+                place(index);
+            }
+            index = next;
+        }
+        return deferred;
+    }
+};
+
+template<typename T>
+constexpr std::size_t TimerWheel<T>::slot_bits;
+
+template<typename T>
+constexpr std::size_t TimerWheel<T>::slots_per_level;
+
+template<typename T>
+constexpr std::size_t TimerWheel<T>::number_of_levels;
+
+template<typename T>
+constexpr std::size_t TimerWheel<T>::no_timer;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_TIMER_WHEEL_HPP_
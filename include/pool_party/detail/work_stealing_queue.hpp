@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_DETAIL_WORK_STEALING_QUEUE_HPP_
+#define POOL_PARTY_DETAIL_WORK_STEALING_QUEUE_HPP_
+
+#include "chase_lev_deque.hpp"
+#include "queue_tags.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+namespace detail {
+
+/**
+ * @brief Task queue with work stealing strategy
+ *
+ * Each worker owns a local Chase-Lev deque. Tasks enqueued by a worker are pushed to its local
+ * deque and popped in lifo order by the same worker, which keeps recently touched data in its
+ * caches. Idle workers steal the oldest tasks of other workers.
+ *
+ * Tasks enqueued by threads outside of the pool are placed in a shared injection queue. A worker
+ * which takes a task from there moves its share of the remaining injected tasks into its local
+ * deque, so the injection queue lock is not taken for every single task.
+ *
+ * The deques store pointers to task nodes, because thieves read an item before they know if they
+ * won it. Each worker recycles the nodes it takes, so the allocator is only hit until the number
+ * of spare nodes matches the workload.
+ *
+ * The order in which tasks are executed is not specified.
+ *
+ * @tparam Task Type of the stored tasks
+ */
+template<typename Task>
+class WorkStealingQueue {
+public:
+    using synchronization_tag = ConcurrentQueueTag;
+
+    /**
+     * @brief Constructor of WorkStealingQueue
+     *
+     * @param number_of_workers Number of workers, each of them gets its own deque
+     */
+    explicit WorkStealingQueue(std::size_t number_of_workers) : m_workers(number_of_workers) {}
+    WorkStealingQueue(const WorkStealingQueue&)            = delete;
+    WorkStealingQueue(WorkStealingQueue&&)                 = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(WorkStealingQueue&&)      = delete;
+
+    /**
+     * @brief Destructor releases all tasks which were not executed
+     */
+    ~WorkStealingQueue() {
+        for (auto& worker : m_workers) {
+            Task* node{nullptr};
+            while (worker.local_queue.pop(node)) {
+                std::unique_ptr<Task> owned_node{node};
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes a task either to the local deque of a worker or to the injection queue
+     *
+     * @param task Task which is moved into the queue
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Always true, the queue is unbounded
+     */
+    bool push(Task&& task, std::size_t worker_index) {
+        if (worker_index < m_workers.size()) {
+            pushLocal(std::move(task), worker_index);
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lg{m_injection_mtx};
+        m_injected_tasks.push_back(std::move(task));
+        m_injected_count.store(m_injected_tasks.size());
+        return true;
+    }
+
+    /**
+     * @brief Pushes a range of tasks either to the local deque of a worker or to the injection queue
+     *
+     * Threads outside of the pool take the injection queue lock only once for the whole range.
+     *
+     * @tparam Iterator Iterator type of the task range
+     *
+     * @param first Iterator to the first task, the tasks are moved into the queue
+     * @param last Iterator behind the last task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns Always last, the queue is unbounded
+     */
+    template<typename Iterator>
+    Iterator push(Iterator first, Iterator last, std::size_t worker_index) {
+        if (worker_index < m_workers.size()) {
+            for (; first != last; ++first) {
+                pushLocal(std::move(*first), worker_index);
+            }
+            return last;
+        }
+
+        std::lock_guard<std::mutex> lg{m_injection_mtx};
+        m_injected_tasks.insert(m_injected_tasks.end(), std::make_move_iterator(first), std::make_move_iterator(last));
+        m_injected_count.store(m_injected_tasks.size());
+        return last;
+    }
+
+    /**
+     * @brief Takes a task from the queue
+     *
+     * Workers try their local deque first, then the injection queue and steal from the other
+     * workers as last resort. Threads outside of the pool skip the first step.
+     *
+     * @param task Receives the taken task
+     * @param worker_index Index of the calling worker, pool_party::detail::no_worker_index otherwise
+     *
+     * @returns True if a task was taken, false if no task was found
+     */
+    bool tryPop(Task& task, std::size_t worker_index) {
+        return popLocal(task, worker_index) || popInjected(task, worker_index) || steal(task, worker_index);
+    }
+
+    /**
+     * @brief Checks if the queue contains tasks
+     *
+     * @returns True if no task is queued, may be outdated when other threads modify the queue
+     */
+    bool empty() const {
+        if (m_injected_count.load() != 0) {
+            return false;
+        }
+
+        return std::all_of(m_workers.begin(), m_workers.end(), [](const Worker& worker) {
+            return worker.local_queue.empty();
+        });
+    }
+
+private:
+    /**
+     * @brief State which belongs to a single worker
+     */
+    struct Worker {
+        ChaseLevDeque<Task*> local_queue{};                ///< Deque which is owned by the worker
+        std::vector<std::unique_ptr<Task>> spare_nodes{};  ///< Recycled nodes, only touched by the worker
+    };
+
+    static constexpr std::size_t max_injection_batch{32};  ///< Upper limit of injected tasks moved at once
+    static constexpr std::size_t max_spare_nodes{256};     ///< Upper limit of recycled nodes per worker
+
+    std::vector<Worker> m_workers;                 ///< State of each worker
+    std::mutex m_injection_mtx{};                  ///< Guards the injection queue
+    std::deque<Task> m_injected_tasks{};           ///< Tasks which were enqueued from outside of the pool
+    std::atomic<std::size_t> m_injected_count{0};  ///< Size of the injection queue, readable without lock
+
+    /**
+     * @brief Moves a task into a node and pushes it to the local deque of a worker
+     *
+     * @pre Must only be called by the worker with the passed index
+     */
+    void pushLocal(Task&& task, std::size_t worker_index) {
+        auto& spare_nodes{m_workers[worker_index].spare_nodes};
+        std::unique_ptr<Task> node{};
+        if (spare_nodes.empty()) {
+            node.reset(new Task{std::move(task)});
+        } else {
+            node = std::move(spare_nodes.back());
+            spare_nodes.pop_back();
+            *node = std::move(task);
+        }
+        m_workers[worker_index].local_queue.push(node.release());
+    }
+
+    /**
+     * @brief Moves a task out of its node and recycles the node
+     */
+    void take(Task& task, Task* node, std::size_t worker_index) {
+        std::unique_ptr<Task> owned_node{node};
+        task = std::move(*owned_node);
+
+        if (worker_index < m_workers.size() && m_workers[worker_index].spare_nodes.size() < max_spare_nodes) {
+            m_workers[worker_index].spare_nodes.push_back(std::move(owned_node));
+        }
+    }
+
+    bool popLocal(Task& task, std::size_t worker_index) {
+        Task* node{nullptr};
+        if (worker_index >= m_workers.size() || !m_workers[worker_index].local_queue.pop(node)) {
+            return false;
+        }
+
+        take(task, node, worker_index);
+        return true;
+    }
+
+    bool popInjected(Task& task, std::size_t worker_index) {
+        if (m_injected_count.load() == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lg{m_injection_mtx};
+        if (m_injected_tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(m_injected_tasks.front());
+        m_injected_tasks.pop_front();
+
+        if (worker_index < m_workers.size()) {
+            // Take a fair share of the remaining tasks, other idle workers can steal them from here
+            auto batch_size{std::min(m_injected_tasks.size() / m_workers.size(), max_injection_batch)};
+            for (; batch_size > 0; --batch_size) {
+                pushLocal(std::move(m_injected_tasks.front()), worker_index);
+                m_injected_tasks.pop_front();
+            }
+        }
+
+        m_injected_count.store(m_injected_tasks.size());
+        return true;
+    }
+
+    bool steal(Task& task, std::size_t worker_index) {
+        // Each thread starts at a different victim to spread the thieves across the workers
+        static thread_local std::size_t victim_offset{0};
+        ++victim_offset;
+
+        const auto number_of_workers{m_workers.size()};
+        for (std::size_t attempt{0}; attempt < number_of_workers; ++attempt) {
+            const auto victim_index{(victim_offset + attempt) % number_of_workers};
+            Task* node{nullptr};
+            if (victim_index != worker_index && m_workers[victim_index].local_queue.steal(node)) {
+                take(task, node, worker_index);
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+template<typename Task>
+constexpr std::size_t WorkStealingQueue<Task>::max_injection_batch;
+
+template<typename Task>
+constexpr std::size_t WorkStealingQueue<Task>::max_spare_nodes;
+
+}  // namespace detail
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_DETAIL_WORK_STEALING_QUEUE_HPP_
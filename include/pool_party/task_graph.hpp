@@ -0,0 +1,355 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_TASK_GRAPH_HPP_
+#define POOL_PARTY_TASK_GRAPH_HPP_
+
+#include "detail/future.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pool_party {
+
+/**
+ * @brief Reusable graph of tasks whose edges define the order of execution
+ *
+ * A node is posted to the pool as soon as its last predecessor finished, no thread blocks while
+ * waiting for predecessors. The graph can be submitted again after a run finished, the structure
+ * is only built once.
+ *
+ * When a node throws, the nodes which didn't start yet are skipped and the exception is passed
+ * to the future of the run. A node which the pool drops without running it, e.g. by shutdownNow,
+ * fails the run the same way with std::future_error. The destructor waits for the active run.
+ */
+class TaskGraph {
+public:
+    using NodeId = std::size_t;  ///< Identifies a node within its graph
+
+    TaskGraph()                            = default;
+    TaskGraph(const TaskGraph&)            = delete;
+    TaskGraph(TaskGraph&&)                 = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph& operator=(TaskGraph&&)      = delete;
+
+    /**
+     * @brief Waits for the active run
+     */
+    ~TaskGraph() {
+        if (m_run.valid()) {
+            m_run.wait();
+        }
+    }
+
+    /**
+     * @brief Adds a node
+     *
+     * @param work Callable which is executed when the node runs
+     *
+     * @returns Id of the new node
+     *
+     * @exception std::logic_error is thrown when the graph is running
+     */
+    NodeId addNode(std::function<void()> work) {
+        throwWhenRunning();
+        m_nodes.push_back(Node{std::move(work), {}, 0});
+        return m_nodes.size() - 1;
+    }
+
+    /**
+     * @brief Adds an edge, the successor runs after the predecessor finished
+     *
+     * @param predecessor Id of the node which runs first
+     * @param successor Id of the node which runs afterwards
+     *
+     * @exception std::out_of_range is thrown when a node doesn't belong to the graph
+     * @exception std::invalid_argument is thrown when both nodes are the same
+     * @exception std::logic_error is thrown when the graph is running
+     */
+    void addEdge(NodeId predecessor, NodeId successor) {
+        throwWhenRunning();
+        if (predecessor >= m_nodes.size() || successor >= m_nodes.size()) {
+            throw std::out_of_range{"Task graph node doesn't exist."};
+        }
+        if (predecessor == successor) {
+            throw std::invalid_argument{"Task graph node can't depend on itself."};
+        }
+
+        m_nodes[predecessor].successors.push_back(successor);
+        ++m_nodes[successor].number_of_predecessors;
+        m_is_validated = false;
+    }
+
+    /**
+     * @brief Returns the number of nodes
+     */
+    std::size_t getNumberOfNodes() const {
+        return m_nodes.size();
+    }
+
+    /**
+     * @brief Submits all nodes of the graph to a thread pool
+     *
+     * The nodes without predecessors are posted immediately, all others as soon as their last
+     * predecessor finished.
+     *
+     * @tparam Pool Thread pool type which provides post
+     *
+     * @param pool Thread pool which executes the nodes
+     *
+     * @returns Future which becomes ready when all nodes finished and holds the first exception of a node
+     *
+     * @exception std::invalid_argument is thrown when the edges contain a cycle
+     * @exception std::logic_error is thrown when the graph is still running
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Pool>
+    std::shared_future<void> submit(Pool& pool) {
+        throwWhenRunning();
+        validate();
+
+        auto run{std::make_shared<Run>(m_nodes)};
+        std::shared_future<void> finished{run->promise.get_future().share()};
+        if (m_nodes.empty()) {
+            run->promise.set_value();
+            return finished;
+        }
+
+        std::vector<NodeId> roots{};
+        for (NodeId node{0}; node < m_nodes.size(); ++node) {
+            if (m_nodes[node].number_of_predecessors == 0) {
+                roots.push_back(node);
+            }
+        }
+
+        // A root which can't be posted is never started, so the first one decides about the whole run
+        postNodeTask(run, pool, roots.front());
+        for (auto root{roots.begin() + 1}; root != roots.end(); ++root) {
+            postNode(run, pool, *root);
+        }
+
+        m_run = finished;
+        return finished;
+    }
+
+private:
+    /**
+     * @brief Work and edges of a node
+     */
+    struct Node {
+        std::function<void()> work;          ///< Callable which is executed when the node runs
+        std::vector<NodeId> successors;      ///< Nodes which run after this node
+        std::size_t number_of_predecessors;  ///< Number of nodes which run before this node
+    };
+
+    /**
+     * @brief Progress of posting a node, decides who completes a node which the pool drops
+     */
+    enum class PostState : std::uint8_t { posting, queued, dropped };
+
+    /**
+     * @brief State of a single run which is shared by all of its tasks
+     */
+    struct Run {
+        explicit Run(const std::vector<Node>& graph_nodes) :
+                nodes{graph_nodes},
+                pending_predecessors{new std::atomic<std::size_t>[graph_nodes.size()]},
+                post_states{new std::atomic<PostState>[graph_nodes.size()]},
+                pending_nodes{graph_nodes.size()} {
+            for (std::size_t node{0}; node < nodes.size(); ++node) {
+                pending_predecessors[node].store(nodes[node].number_of_predecessors);
+                post_states[node].store(PostState::posting);
+            }
+        }
+
+        const std::vector<Node>& nodes;                                    ///< Nodes of the graph
+        std::unique_ptr<std::atomic<std::size_t>[]> pending_predecessors;  ///< Unfinished predecessors per node
+        std::unique_ptr<std::atomic<PostState>[]> post_states;             ///< Progress of posting per node
+        std::atomic<std::size_t> pending_nodes;                            ///< Number of unfinished nodes
+        std::atomic<bool> failed{false};                                   ///< Set when a node has thrown
+        std::mutex mtx{};                                                  ///< Guards the exception
+        std::exception_ptr exception{};                                    ///< First exception of a node
+        std::promise<void> promise{};                                      ///< Signals the end of the run
+    };
+
+    /**
+     * @brief Task which executes a node, or completes it as failed if the pool drops the task
+     *
+     * @tparam Pool Thread pool type which executes the node
+     */
+    template<typename Pool>
+    class NodeTask {
+    public:
+        NodeTask(std::shared_ptr<Run> run, Pool& pool, NodeId node) :
+                m_run{std::move(run)}, m_pool{pool}, m_node{node} {}
+
+        NodeTask(NodeTask&&) = default;
+
+        ~NodeTask() {
+            // A task which post refused is handled by postNode, a queued one is dropped here
+            if (m_run && m_run->post_states[m_node].exchange(PostState::dropped) == PostState::queued) {
+                dropNode(m_run, m_pool.get(), m_node);
+            }
+        }
+
+        void operator()() {
+            const auto run{std::move(m_run)};
+            executeNode(run, m_pool.get(), m_node);
+        }
+
+    private:
+        std::shared_ptr<Run> m_run;           ///< State of the run, nullptr once the node was executed
+        std::reference_wrapper<Pool> m_pool;  ///< Thread pool which executes the node
+        NodeId m_node;                        ///< Node which is executed
+    };
+
+    std::vector<Node> m_nodes{};       ///< Nodes of the graph, indexed by their id
+    bool m_is_validated{true};         ///< False if edges were added since the last cycle check
+    std::shared_future<void> m_run{};  ///< Future of the last run
+
+    /**
+     * @brief Posts a node to the pool
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Pool>
+    static void postNodeTask(const std::shared_ptr<Run>& run, Pool& pool, NodeId node) {
+        pool.post(NodeTask<Pool>{run, pool, node});
+        if (run->post_states[node].exchange(PostState::queued) == PostState::dropped) {
+            // The pool dropped the task before it was marked as queued
+            dropNode(run, pool, node);
+        }
+    }
+
+    template<typename Pool>
+    static void postNode(const std::shared_ptr<Run>& run, Pool& pool, NodeId node) {
+        try {
+            postNodeTask(run, pool, node);
+        } catch (...) {
+            // The pool was shut down during the run, finish it on the current thread
+            executeNode(run, pool, node);
+        }
+    }
+
+    template<typename Pool>
+    static void executeNode(const std::shared_ptr<Run>& run, Pool& pool, NodeId node) {
+        if (!run->failed.load()) {
+            try {
+                run->nodes[node].work();
+            } catch (...) {
+                fail(*run, std::current_exception());
+            }
+        }
+
+        for (const auto successor : run->nodes[node].successors) {
+            if (--run->pending_predecessors[successor] == 0) {
+                postNode(run, pool, successor);
+            }
+        }
+
+        if (--run->pending_nodes == 0) {
+            finish(*run);
+        }
+    }
+
+    /**
+     * @brief Completes a node which the pool dropped, the nodes which didn't start yet are skipped
+     */
+    template<typename Pool>
+    static void dropNode(const std::shared_ptr<Run>& run, Pool& pool, NodeId node) {
+        fail(*run, detail::makeBrokenPromise());
+        executeNode(run, pool, node);
+    }
+
+    static void fail(Run& run, std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lg{run.mtx};
+        if (!run.exception) {
+            run.exception = std::move(exception);
+        }
+        run.failed.store(true);
+    }
+
+    static void finish(Run& run) {
+        if (run.exception) {
+            run.promise.set_exception(run.exception);
+        } else {
+            run.promise.set_value();
+        }
+    }
+
+    void throwWhenRunning() const {
+        if (m_run.valid() && m_run.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            throw std::logic_error{"Task graph is still running."};
+        }
+    }
+
+    /**
+     * @brief Checks that the edges contain no cycle, otherwise some nodes would never run
+     *
+     * @exception std::invalid_argument is thrown when the edges contain a cycle
+     */
+    void validate() {
+        if (m_is_validated) {
+            return;
+        }
+
+        std::vector<std::size_t> pending_predecessors{};
+        std::vector<NodeId> ready_nodes{};
+        for (NodeId node{0}; node < m_nodes.size(); ++node) {
+            pending_predecessors.push_back(m_nodes[node].number_of_predecessors);
+            if (pending_predecessors.back() == 0) {
+                ready_nodes.push_back(node);
+            }
+        }
+
+        std::size_t number_of_visited_nodes{0};
+        while (!ready_nodes.empty()) {
+            const auto node{ready_nodes.back()};
+            ready_nodes.pop_back();
+            ++number_of_visited_nodes;
+            for (const auto successor : m_nodes[node].successors) {
+                if (--pending_predecessors[successor] == 0) {
+                    ready_nodes.push_back(successor);
+                }
+            }
+        }
+
+        if (number_of_visited_nodes != m_nodes.size()) {
+            throw std::invalid_argument{"Task graph contains a cycle."};
+        }
+        m_is_validated = true;
+    }
+};
+
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_TASK_GRAPH_HPP_
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_PARTY_TASK_GROUP_HPP_
+#define POOL_PARTY_TASK_GROUP_HPP_
+
+#include "detail/future.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace pool_party {
+
+/**
+ * @brief Group of tasks which are forked on a thread pool and joined together
+ *
+ * In contrast to blocking on a future, a thread which waits for the group executes pending
+ * tasks of the pool until all tasks of the group are finished. Waiting workers therefore keep
+ * the pool busy, which makes recursive divide and conquer algorithms safe even on small pools.
+ *
+ * The destructor waits for all tasks of the group, exceptions are dropped then. Tasks which the
+ * pool drops without running them, e.g. by shutdownNow, count as finished with a broken promise.
+ *
+ * @tparam Pool Thread pool type which provides post and tryExecuteTask
+ */
+template<typename Pool>
+class TaskGroup {
+public:
+    static constexpr std::chrono::microseconds help_interval{100};  ///< Interval between attempts to help
+
+    /**
+     * @brief Constructor of TaskGroup
+     *
+     * @param pool Thread pool which executes the tasks of the group
+     */
+    explicit TaskGroup(Pool& pool) : m_pool{pool} {}
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+    /**
+     * @brief Waits for all tasks of the group
+     */
+    ~TaskGroup() {
+        try {
+            wait();
+        } catch (...) {
+            // Exceptions are only reported by an explicit wait
+        }
+    }
+
+    /**
+     * @brief Runs a task as part of the group
+     *
+     * @tparam Callable Type of tasks function
+     *
+     * @param callable The callable which contains the task
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable>
+    void run(Callable&& callable) {
+        using TaskType = GroupTask<typename std::decay<Callable>::type>;
+
+        // The second count keeps the group pending while a refused task is told apart from a dropped one
+        m_state->pending_tasks += 2;
+        try {
+            m_pool.get().post(TaskType{m_state, std::forward<Callable>(callable)});
+        } catch (...) {
+            // The refused task was destroyed and counted itself as dropped
+            --m_state->dropped_tasks;
+            m_state->finishTask();
+            throw;
+        }
+        m_state->finishTask();
+    }
+
+    /**
+     * @brief Waits until all tasks of the group are finished
+     *
+     * The calling thread executes pending tasks of the pool in the meantime. The group can be
+     * reused afterwards.
+     *
+     * @exception Rethrows the first exception of a task of the group, std::future_error if a task
+     *            was dropped by the pool
+     */
+    void wait() {
+        auto& state{*m_state};
+        while (state.pending_tasks.load() != 0) {
+            if (m_pool.get().tryExecuteTask()) {
+                continue;
+            }
+
+            // Tasks of the group run on other threads, check for new pending tasks now and then
+            std::unique_lock<std::mutex> ul{state.mtx};
+            state.cv.wait_for(ul, help_interval, [&state]() { return state.pending_tasks.load() == 0; });
+        }
+
+        std::exception_ptr exception{};
+        {
+            std::lock_guard<std::mutex> lg{state.mtx};
+            std::swap(exception, state.exception);
+        }
+        if (state.dropped_tasks.exchange(0) != 0 && !exception) {
+            exception = detail::makeBrokenPromise();
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    /**
+     * @brief State which is shared with the tasks, so a finishing task never touches a destroyed group
+     */
+    struct State {
+        std::atomic<std::size_t> pending_tasks{0};  ///< Number of tasks which are not finished yet
+        std::atomic<std::size_t> dropped_tasks{0};  ///< Number of tasks which the pool dropped without running
+        std::mutex mtx{};                           ///< Guards the exception and the completion signal
+        std::condition_variable cv{};               ///< Signals that the last pending task finished
+        std::exception_ptr exception{};             ///< First exception of a task of the group
+
+        void storeException(std::exception_ptr task_exception) {
+            std::lock_guard<std::mutex> lg{mtx};
+            if (!exception) {
+                exception = std::move(task_exception);
+            }
+        }
+
+        void finishTask() {
+            if (--pending_tasks == 0) {
+                std::lock_guard<std::mutex> lg{mtx};
+                cv.notify_all();
+            }
+        }
+    };
+
+    /**
+     * @brief Task of the group which finishes in the shared state even if the pool drops it
+     *
+     * @tparam Callable Type of the wrapped callable
+     */
+    template<typename Callable>
+    class GroupTask {
+    public:
+        template<typename Function>
+        GroupTask(std::shared_ptr<State> state, Function&& function) :
+                m_state{std::move(state)}, m_callable(std::forward<Function>(function)) {}
+
+        GroupTask(GroupTask&&) = default;
+
+        ~GroupTask() {
+            if (m_state) {
+                ++m_state->dropped_tasks;
+                m_state->finishTask();
+            }
+        }
+
+        void operator()() {
+            const auto state{std::move(m_state)};
+            try {
+                m_callable();
+            } catch (...) {
+                state->storeException(std::current_exception());
+            }
+            state->finishTask();
+        }
+
+    private:
+        std::shared_ptr<State> m_state;  ///< State of the group, nullptr once the task ran
+        Callable m_callable;             ///< Wrapped callable
+    };
+
+    std::reference_wrapper<Pool> m_pool;                        ///< Thread pool which executes the tasks
+    std::shared_ptr<State> m_state{std::make_shared<State>()};  ///< State which is shared with the tasks
+};
+
+template<typename Pool>
+constexpr std::chrono::microseconds TaskGroup<Pool>::help_interval;
+
+}  // namespace pool_party
+
+#endif  // POOL_PARTY_TASK_GROUP_HPP_
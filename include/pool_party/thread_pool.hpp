@@ -23,34 +23,176 @@
 #ifndef POOL_PARTY_THREAD_POOL_HPP_
 #define POOL_PARTY_THREAD_POOL_HPP_
 
+#include "detail/cancellation.hpp"
+#include "detail/fifo_queue.hpp"
+#include "detail/future.hpp"
+#include "detail/lifo_slot_queue.hpp"
+#include "detail/mpmc_ring_queue.hpp"
+#include "detail/numa_queue.hpp"
+#include "detail/pinned_thread_factory.hpp"
+#include "detail/priority_queue.hpp"
+#include "detail/spin_sync.hpp"
+#include "detail/strand.hpp"
 #include "detail/sync.hpp"
+#include "detail/task.hpp"
 #include "detail/thread_factory.hpp"
 #include "detail/thread_joiner.hpp"
 #include "detail/thread_pool.hpp"
+#include "detail/timer_wheel.hpp"
+#include "detail/work_stealing_queue.hpp"
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <functional>
 #include <future>
+#include <iterator>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace pool_party {
+/**
+ * @brief Priority levels of tasks, see pool_party::PriorityThreadPool
+ */
+using Priority = detail::Priority;
+
+/**
+ * @brief Bounds of the number of workers of an elastic thread pool
+ */
+using ElasticLimits = detail::ElasticLimits;
+
+/**
+ * @brief Reasons of the hill climbing controller for choosing a worker target
+ */
+using ConcurrencyReason = detail::ConcurrencyReason;
+
+/**
+ * @brief Decision of the hill climbing controller, see BasicThreadPool::setConcurrencyObserver
+ */
+using ConcurrencyDecision = detail::ConcurrencyDecision;
+
+/**
+ * @brief Key of a strand, see BasicThreadPool::enqueue(StrandKey, Callable&&, Args&&...)
+ */
+using StrandKey = detail::StrandKey;
+
+/**
+ * @brief Handle of a scheduled task, see BasicThreadPool::cancelTimer
+ */
+using TimerId = detail::TimerId;
+
+/**
+ * @brief Move-only task, handed back by BasicThreadPool::shutdownNow
+ */
+using Task = detail::Task;
+
+/**
+ * @brief Requests the cancellation of tasks, see BasicThreadPool::enqueue(CancellationToken, Callable&&, Args&&...)
+ */
+using CancellationSource = detail::CancellationSource;
+
+/**
+ * @brief Observes a CancellationSource, passed to the tasks which can be cancelled
+ */
+using CancellationToken = detail::CancellationToken;
+
+/**
+ * @brief Exception which reports that a task was cancelled
+ */
+using TaskCancelled = detail::TaskCancelled;
+
+/**
+ * @brief Future with non-blocking continuations, returned by submit
+ */
+template<typename R>
+using Future = detail::Future<R>;
+
 /**
  * @brief ThreadPool implementation
  *
  * This class contains the thread pool client interface.
+ *
+ * @tparam Queue Scheduler policy, the task queue template which decides how tasks are distributed
+ *               to the worker threads
+ * @tparam Sync Waiting strategy, the sync type which parks and wakes up idle worker threads
+ * @tparam ThreadFactory Factory which creates the worker threads, e.g.
+ *                       pool_party::detail::PinnedThreadFactory to pin the workers to CPUs
+ *
+ * @see pool_party::ThreadPool
+ * @see pool_party::WorkStealingThreadPool
+ * @see pool_party::SpinningThreadPool
  */
-class ThreadPool {
+template<template<typename> class Queue,
+         typename Sync          = detail::Sync<std::mutex, std::condition_variable>,
+         typename ThreadFactory = detail::ThreadFactory<std::thread>>
+class BasicThreadPool {
 public:
     /**
-     * @brief Constructor of ThreadPool
+     * @brief Constructor of BasicThreadPool
      *
      * This function creates all neccessary threads and prepares them to work on the
      * thread pools tasks.
      *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
+     * @param number_of_threads The number of threads the thread pool should consist of.
+     * @param queue_args Additional arguments which are passed to the task queue constructor,
+     *                   e.g. the capacity of a pool_party::RingBufferThreadPool
+     */
+    template<typename... QueueArgs>
+    explicit BasicThreadPool(std::size_t number_of_threads, QueueArgs&&... queue_args) :
+            m_thread_pool{number_of_threads, m_thread_factory, m_sync, std::forward<QueueArgs>(queue_args)...} {}
+
+    /**
+     * @brief Constructor of BasicThreadPool with a preconfigured thread factory
+     *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
      * @param number_of_threads The number of threads the thread pool should consist of.
+     * @param thread_factory Factory which creates the worker threads, e.g. a
+     *                       pool_party::detail::PinnedThreadFactory with an explicit CPU list
+     * @param queue_args Additional arguments which are passed to the task queue constructor
+     */
+    template<typename... QueueArgs>
+    BasicThreadPool(std::size_t number_of_threads, ThreadFactory thread_factory, QueueArgs&&... queue_args) :
+            m_thread_factory{std::move(thread_factory)},
+            m_thread_pool{number_of_threads, m_thread_factory, m_sync, std::forward<QueueArgs>(queue_args)...} {}
+
+    /**
+     * @brief Constructor of an elastic BasicThreadPool
+     *
+     * The number of workers follows the load within the limits. Workers are added while tasks
+     * queue up and no worker is idle, workers above the minimum retire after the keep alive
+     * duration without work.
+     *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
+     * @param limits Bounds of the number of workers and thresholds for growing and shrinking
+     * @param queue_args Additional arguments which are passed to the task queue constructor
+     *
+     * @exception std::invalid_argument is thrown when the minimum is zero or above the maximum
+     */
+    template<typename... QueueArgs>
+    explicit BasicThreadPool(const ElasticLimits& limits, QueueArgs&&... queue_args) :
+            m_thread_pool{limits, m_thread_factory, m_sync, std::forward<QueueArgs>(queue_args)...} {}
+
+    /**
+     * @brief Constructor of an elastic BasicThreadPool with a preconfigured thread factory
+     *
+     * @tparam QueueArgs Types of additional task queue constructor arguments
+     *
+     * @param limits Bounds of the number of workers and thresholds for growing and shrinking
+     * @param thread_factory Factory which creates the worker threads
+     * @param queue_args Additional arguments which are passed to the task queue constructor
+     *
+     * @exception std::invalid_argument is thrown when the minimum is zero or above the maximum
      */
-    explicit ThreadPool(std::size_t number_of_threads) : m_thread_pool{number_of_threads, m_thread_factory, m_sync} {}
+    template<typename... QueueArgs>
+    BasicThreadPool(const ElasticLimits& limits, ThreadFactory thread_factory, QueueArgs&&... queue_args) :
+            m_thread_factory{std::move(thread_factory)},
+            m_thread_pool{limits, m_thread_factory, m_sync, std::forward<QueueArgs>(queue_args)...} {}
 
     /**
      * @brief Enqueue a new task
@@ -61,6 +203,8 @@ public:
      * After signaling a shutdown, enqueuing new tasks is NOT allowed and punished with a
      * corresponding exception.
      *
+     * While a bounded task queue is full, the caller blocks until a worker frees a slot.
+     *
      * @tparam Callable Type of tasks function
      * @tparam Args Variadic template type of tasks function arguments
      * @tparam R Automatically generated result type
@@ -68,7 +212,8 @@ public:
      * @param callable The callable which contains the task
      * @param args Variadic arguments which are passed to the tasks callable
      *
-     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::runtime_error is thrown when the thread pool is already shut down or shuts
+     *                               down while waiting for a free slot
      *
      * @returns std::future<R> with tasks result
      */
@@ -77,6 +222,525 @@ public:
         return m_thread_pool.enqueue(std::forward<Callable>(callable), std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Enqueue a new task if the bounded task queue has room
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result, an invalid future if the queue is full
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> tryEnqueue(Callable&& callable, Args&&... args) {
+        return m_thread_pool.tryEnqueue(std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Enqueue a new task, waiting at most the timeout for room in the bounded task queue
+     *
+     * @tparam Rep Arithmetic type of the timeout ticks
+     * @tparam Period Tick period of the timeout
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param timeout Maximum duration to wait for a free slot
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down or shuts
+     *                               down while waiting
+     *
+     * @returns std::future<R> with tasks result, an invalid future if the queue stayed full
+     */
+    template<typename Rep,
+             typename Period,
+             typename Callable,
+             typename... Args,
+             typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueueFor(const std::chrono::duration<Rep, Period>& timeout, Callable&& callable, Args&&... args) {
+        return m_thread_pool.enqueueFor(timeout, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Post a new task without result
+     *
+     * This function allows to pass a new task to the thread pool when its result is not needed.
+     * In contrast to enqueue, no future and no shared state is created, which makes posting
+     * cheaper. Exceptions which escape the task are passed to the exception handler.
+     *
+     * After signaling a shutdown, posting new tasks is NOT allowed and punished with a
+     * corresponding exception.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable, typename... Args>
+    void post(Callable&& callable, Args&&... args) {
+        m_thread_pool.post(std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Submit a new task whose result is consumed by continuations
+     *
+     * The returned future has a lock-free shared state. Continuations which are attached with
+     * then() are scheduled on this pool as soon as the result is ready, so no thread blocks while
+     * waiting for it. The pool has to outlive futures which receive continuations.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns pool_party::Future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    Future<R> submit(Callable&& callable, Args&&... args) {
+        return m_thread_pool.submit(std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Enqueue a new task with a priority
+     *
+     * Works like enqueue, but the task overtakes queued tasks of lower priorities. Only
+     * available for pool_party::PriorityThreadPool.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param priority Priority of the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(Priority priority, Callable&& callable, Args&&... args) {
+        return m_thread_pool.enqueue(priority, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Post a new task without result with a priority
+     *
+     * Works like post, but the task overtakes queued tasks of lower priorities. Only available
+     * for pool_party::PriorityThreadPool.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param priority Priority of the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable, typename... Args>
+    void post(Priority priority, Callable&& callable, Args&&... args) {
+        m_thread_pool.post(priority, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Enqueue a new task on a strand
+     *
+     * Tasks with the same key are executed in the order they were enqueued and never in
+     * parallel, tasks with different keys run in parallel. Works with all queue types.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param key Key of the strand
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(StrandKey key, Callable&& callable, Args&&... args) {
+        return m_thread_pool.enqueue(key, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Post a new task without result on a strand
+     *
+     * Works like post, but tasks with the same key are executed in order and never in parallel.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param key Key of the strand
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable, typename... Args>
+    void post(StrandKey key, Callable&& callable, Args&&... args) {
+        m_thread_pool.post(key, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Enqueue a new task which can be cancelled
+     *
+     * A task whose token is cancelled before a worker starts it is skipped without calling the
+     * callable, its future receives pool_party::TaskCancelled. Running tasks can poll the token
+     * themselves, e.g. by capturing a copy of it.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param token Token which cancels the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueue(CancellationToken token, Callable&& callable, Args&&... args) {
+        return m_thread_pool.enqueue(std::move(token), std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Post a new task without result which can be cancelled
+     *
+     * A task whose token is cancelled before a worker starts it is skipped without calling the
+     * callable. Neither skipped tasks nor tasks which throw pool_party::TaskCancelled are reported
+     * to the exception handler.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param token Token which cancels the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable, typename... Args>
+    void post(CancellationToken token, Callable&& callable, Args&&... args) {
+        m_thread_pool.post(std::move(token), std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Schedule a task without result to run once after a delay
+     *
+     * The task waits in a timer wheel instead of occupying a worker and is pushed into the task
+     * queue when it is due. The timer thread is created with the first timer and never pinned by
+     * the thread factory. Timers have a resolution of one millisecond and never fire early,
+     * pending timers are dropped on shutdown.
+     *
+     * @tparam Rep Arithmetic type of the delay
+     * @tparam Period Tick period of the delay
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param delay Duration after which the task is pushed into the task queue
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Rep, typename Period, typename Callable, typename... Args>
+    TimerId scheduleAfter(const std::chrono::duration<Rep, Period>& delay, Callable&& callable, Args&&... args) {
+        return m_thread_pool.scheduleAfter(delay, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Schedule a task without result to run once at a point in time
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param time Point in time at which the task is pushed into the task queue
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Callable, typename... Args>
+    TimerId scheduleAt(std::chrono::steady_clock::time_point time, Callable&& callable, Args&&... args) {
+        return m_thread_pool.scheduleAt(time, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Schedule a task without result to run periodically
+     *
+     * The first run is due after one period. A run is skipped while the previous run of the same
+     * timer is still executing, missed periods are not caught up.
+     *
+     * @tparam Rep Arithmetic type of the period
+     * @tparam Period Tick period of the period
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param period Duration between two runs, at least one millisecond
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns Handle which cancels the timer
+     */
+    template<typename Rep, typename Period, typename Callable, typename... Args>
+    TimerId scheduleEvery(const std::chrono::duration<Rep, Period>& period, Callable&& callable, Args&&... args) {
+        return m_thread_pool.scheduleEvery(period, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Cancel a scheduled task
+     *
+     * A due run which already waits in the task queue is skipped as well.
+     *
+     * @param id Handle of the timer
+     *
+     * @returns True if the timer was cancelled, false if it already fired or was cancelled before
+     */
+    bool cancelTimer(TimerId id) {
+        return m_thread_pool.cancelTimer(id);
+    }
+
+    /**
+     * @brief Enqueue a new task for a specific NUMA node
+     *
+     * Works like enqueue, but the task is placed in the queue of the given node instead of the
+     * node of the caller. Only available for pool_party::NumaThreadPool.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     * @tparam R Automatically generated result type
+     *
+     * @param node Id of the NUMA node whose workers should execute the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::out_of_range is thrown when the node is not available
+     *
+     * @returns std::future<R> with tasks result
+     */
+    template<typename Callable, typename... Args, typename R = typename std::result_of<Callable(Args...)>::type>
+    std::future<R> enqueueOn(std::size_t node, Callable&& callable, Args&&... args) {
+        return m_thread_pool.enqueueOn(node, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Post a new task without result for a specific NUMA node
+     *
+     * Works like post, but the task is placed in the queue of the given node instead of the
+     * node of the caller. Only available for pool_party::NumaThreadPool.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam Args Variadic template type of tasks function arguments
+     *
+     * @param node Id of the NUMA node whose workers should execute the task
+     * @param callable The callable which contains the task
+     * @param args Variadic arguments which are passed to the tasks callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     * @exception std::out_of_range is thrown when the node is not available
+     */
+    template<typename Callable, typename... Args>
+    void postOn(std::size_t node, Callable&& callable, Args&&... args) {
+        m_thread_pool.postOn(node, std::forward<Callable>(callable), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Enqueue a range of tasks at once
+     *
+     * This function passes many tasks to the thread pool in one go. The queue is accessed once
+     * for the whole range and only as many workers are woken up as there are new tasks, which
+     * is much cheaper than enqueuing the tasks one by one. Each callable of the range is copied.
+     *
+     * @tparam ForwardIterator Iterator type of the callable range
+     * @tparam R Automatically generated result type
+     *
+     * @param first Iterator to the first callable
+     * @param last Iterator behind the last callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::vector of futures with the tasks results in the order of the range
+     */
+    template<typename ForwardIterator,
+             typename R = typename std::result_of<typename std::iterator_traits<ForwardIterator>::reference()>::type>
+    std::vector<std::future<R>> enqueueBulk(ForwardIterator first, ForwardIterator last) {
+        return m_thread_pool.enqueueBulk(first, last);
+    }
+
+    /**
+     * @brief Enqueue a number of tasks which call the same callable with their index
+     *
+     * Works like the range overload, task i calls the callable with i as std::size_t argument.
+     *
+     * @tparam Callable Type of tasks function
+     * @tparam R Automatically generated result type
+     *
+     * @param number_of_tasks Number of tasks to enqueue
+     * @param callable The callable which is copied into each task
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     *
+     * @returns std::vector of futures with the tasks results ordered by index
+     */
+    template<typename Callable, typename R = typename std::result_of<Callable&(std::size_t)>::type>
+    std::vector<std::future<R>> enqueueBulk(std::size_t number_of_tasks, Callable&& callable) {
+        return m_thread_pool.enqueueBulk(number_of_tasks, std::forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Post a range of tasks without results at once
+     *
+     * Combines the batching of enqueueBulk with the fire and forget semantics of post.
+     *
+     * @tparam ForwardIterator Iterator type of the callable range
+     *
+     * @param first Iterator to the first callable
+     * @param last Iterator behind the last callable
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename ForwardIterator>
+    void postBulk(ForwardIterator first, ForwardIterator last) {
+        m_thread_pool.postBulk(first, last);
+    }
+
+    /**
+     * @brief Post a number of tasks without results which call the same callable with their index
+     *
+     * Combines the batching of enqueueBulk with the fire and forget semantics of post.
+     *
+     * @tparam Callable Type of tasks function
+     *
+     * @param number_of_tasks Number of tasks to post
+     * @param callable The callable which is copied into each task
+     *
+     * @exception std::runtime_error is thrown when the thread pool is already shut down
+     */
+    template<typename Callable>
+    void postBulk(std::size_t number_of_tasks, Callable&& callable) {
+        m_thread_pool.postBulk(number_of_tasks, std::forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Sets the handler for exceptions which escape posted tasks
+     *
+     * The handler is called by the worker thread which executed the failed task. Without a
+     * handler, an exception which escapes a posted task calls std::terminate.
+     *
+     * @param exception_handler Callable which receives the exception, an empty handler restores
+     *                          the default behaviour
+     */
+    void setExceptionHandler(std::function<void(std::exception_ptr)> exception_handler) {
+        m_thread_pool.setExceptionHandler(std::move(exception_handler));
+    }
+
+    /**
+     * @brief Sets the observer of the hill climbing controller
+     *
+     * Only elastic pools with a control interval have a controller. The observer is called by a
+     * worker after each sampling interval and must not block.
+     *
+     * @param observer Callable which receives the decisions, an empty observer stops the notifications
+     */
+    void setConcurrencyObserver(std::function<void(const ConcurrencyDecision&)> observer) {
+        m_thread_pool.setConcurrencyObserver(std::move(observer));
+    }
+
+    /**
+     * @brief Changes the number of spin iterations before an idle worker parks
+     *
+     * Only available for waiting strategies which spin, like pool_party::detail::SpinSync.
+     *
+     * @param spin_budget Maximum number of spin iterations, zero disables spinning
+     */
+    void setSpinBudget(std::size_t spin_budget) {
+        m_sync.setSpinBudget(spin_budget);
+    }
+
+    /**
+     * @brief Executes a pending task on the calling thread
+     *
+     * @see pool_party::detail::ThreadPool::tryExecuteTask
+     *
+     * @returns True if a task was executed, false if no task was pending
+     */
+    bool tryExecuteTask() {
+        return m_thread_pool.tryExecuteTask();
+    }
+
+    /**
+     * @brief Blocks until no task is queued and no worker executes a task
+     *
+     * Serves as barrier between phases of work without keeping the futures of the tasks. Tasks of
+     * strands count as queued, pending timers don't. Tasks which are pushed while waiting extend
+     * the wait.
+     *
+     * @pre Must not be called by a task of this pool, which would wait for itself
+     */
+    void waitIdle() {
+        m_thread_pool.waitIdle();
+    }
+
+    /**
+     * @brief Blocks until no task is queued and no worker executes a task, or the timeout expires
+     *
+     * @tparam Rep Arithmetic type of the timeout
+     * @tparam Period Tick period of the timeout
+     *
+     * @param timeout Upper limit of the time to wait
+     *
+     * @returns True if the pool became idle, false on timeout
+     */
+    template<typename Rep, typename Period>
+    bool waitIdleFor(const std::chrono::duration<Rep, Period>& timeout) {
+        return m_thread_pool.waitIdleFor(timeout);
+    }
+
+    /**
+     * @brief Returns the number of worker threads
+     *
+     * Elastic pools return the number of currently running workers.
+     */
+    std::size_t getNumberOfThreads() const {
+        return m_thread_pool.getNumberOfThreads();
+    }
+
+    /**
+     * @brief Returns the upper limit of workers which is currently in effect
+     *
+     * @returns The target of the hill climbing controller, the maximum number of workers without controller
+     */
+    std::size_t getWorkerTarget() const {
+        return m_thread_pool.getWorkerTarget();
+    }
+
     /**
      * @brief Shutdown the thread pool
      *
@@ -88,16 +752,140 @@ public:
         m_thread_pool.shutdown();
     }
 
+    /**
+     * @brief Shutdown the thread pool without processing the queued tasks
+     *
+     * Workers stop taking tasks right away and finish after their current task. The queued tasks,
+     * including the not yet started tasks of batches which workers already took, are handed back
+     * to the caller, who can execute them elsewhere. Dropping them reports a broken promise to the
+     * futures of enqueue and submit.
+     *
+     * The queued tasks of a strand are handed back as a single task, which executes them in order.
+     * Handed back tasks may still refer to the pool, e.g. posted tasks report exceptions to its
+     * handler and continuations are scheduled on it. They have to be executed or dropped before
+     * the pool is destroyed.
+     *
+     * The function returns without waiting for the workers, tasks which are executed at the time
+     * of the call keep running. waitIdle blocks until they are finished, since the handed back
+     * tasks don't count as in flight anymore. The destructor joins the workers.
+     *
+     * @returns The tasks which were queued and not executed, those of taken batches first
+     */
+    std::vector<Task> shutdownNow() {
+        return m_thread_pool.shutdownNow();
+    }
+
+    /**
+     * @brief Shutdown the thread pool and wait a limited time for the queued tasks
+     *
+     * Works like shutdown, but if the workers did not finish all tasks within the timeout, the
+     * remaining tasks are handed back like by shutdownNow.
+     *
+     * @tparam Rep Arithmetic type of the timeout
+     * @tparam Period Tick period of the timeout
+     *
+     * @param timeout Upper limit of the time to wait for the workers
+     *
+     * @returns The tasks which were queued and not executed, empty if all tasks were processed
+     */
+    template<typename Rep, typename Period>
+    std::vector<Task> shutdownFor(const std::chrono::duration<Rep, Period>& timeout) {
+        return m_thread_pool.shutdownFor(timeout);
+    }
+
 private:
-    using SyncType          = pool_party::detail::Sync<std::mutex, std::condition_variable>;
-    using ThreadFactoryType = pool_party::detail::ThreadFactory<std::thread>;
-    using ThreadPoolType    = pool_party::detail::ThreadPool<ThreadFactoryType, SyncType>;
+    using SyncType          = Sync;
+    using ThreadFactoryType = ThreadFactory;
+    using ThreadPoolType    = pool_party::detail::ThreadPool<ThreadFactoryType, SyncType, Queue>;
 
     SyncType m_sync{};                     ///< Sync object which synchronizes the worker threads
     ThreadFactoryType m_thread_factory{};  ///< Thread factory for creating worker threads
     ThreadPoolType m_thread_pool;          ///< Thread pool detail implementation
 };
 
+/**
+ * @brief Thread pool whose workers share a single fifo task queue
+ *
+ * The queue is unbounded by default, a capacity can be passed as second constructor argument.
+ * Producers are blocked while the queue is full, see enqueue, tryEnqueue and enqueueFor.
+ */
+using ThreadPool = BasicThreadPool<detail::FifoQueue>;
+
+/**
+ * @brief Thread pool whose workers run the tasks they enqueue themselves next
+ *
+ * A task enqueued from within a task goes to the next task slot of the worker, so message
+ * passing workloads keep their data in the caches of one core. Idle workers steal from a slot
+ * after a short delay. Tasks from outside of the pool are executed in fifo order. Like for
+ * ThreadPool, a capacity can be passed as second constructor argument.
+ */
+using LifoSlotThreadPool = BasicThreadPool<detail::LifoSlotQueue>;
+
+/**
+ * @brief Thread pool whose workers share a lock-free bounded fifo ring buffer
+ *
+ * Neither enqueuing nor dequeuing takes a lock. The capacity of the ring buffer can be passed as
+ * second constructor argument. When the ring buffer is full, enqueuing workers execute pending
+ * tasks themselves and other threads wait until a slot is free.
+ */
+using RingBufferThreadPool = BasicThreadPool<detail::MpmcRingQueue>;
+
+/**
+ * @brief Thread pool whose workers own local task queues and steal tasks from each other
+ *
+ * Tasks enqueued from within a task are executed by the same worker in lifo order, unless an
+ * idle worker steals them. The order of task execution is not specified.
+ */
+using WorkStealingThreadPool = BasicThreadPool<detail::WorkStealingQueue>;
+
+/**
+ * @brief Thread pool whose idle workers spin for a while before they park
+ *
+ * Tasks which arrive shortly after a worker ran out of work are picked up without the latency of
+ * a kernel wakeup, at the cost of burning CPU time while idle. The spin budget can be changed
+ * with setSpinBudget.
+ *
+ * @tparam Queue Scheduler policy, the fifo queue by default
+ */
+template<template<typename> class Queue = detail::FifoQueue>
+using SpinningThreadPool = BasicThreadPool<Queue, detail::SpinSync<std::mutex, std::condition_variable>>;
+
+/**
+ * @brief Thread pool which executes tasks of higher priority first
+ *
+ * Tasks are enqueued with a pool_party::Priority, tasks without priority have normal priority.
+ * Workers take the oldest task of the highest priority level. A task which was overtaken by more
+ * tasks than the aging threshold is taken next, so low priority tasks can't starve. The aging
+ * threshold can be passed as second constructor argument.
+ */
+using PriorityThreadPool = BasicThreadPool<detail::PriorityQueue>;
+
+/**
+ * @brief Thread pool whose workers are pinned to CPUs
+ *
+ * By default the workers use all CPUs of the process in compact order. Pass a
+ * pool_party::detail::PinnedThreadFactory to the constructor for scatter placement or an
+ * explicit CPU list.
+ *
+ * @tparam Queue Scheduler policy, the fifo queue by default
+ */
+template<template<typename> class Queue = detail::FifoQueue>
+using PinnedThreadPool = BasicThreadPool<Queue,
+                                         detail::Sync<std::mutex, std::condition_variable>,
+                                         detail::PinnedThreadFactory<std::thread>>;
+
+/**
+ * @brief Thread pool with a worker group and a task queue per NUMA node
+ *
+ * The NUMA topology is read from /sys/devices/system/node. Workers are distributed round robin
+ * over the nodes and pinned to the CPUs of their node. Tasks are executed on the node of the
+ * enqueuing thread, unless enqueueOn or postOn select a node. Workers only take tasks of other
+ * nodes when their own node has no tasks left. Machines without NUMA are treated as one node.
+ */
+using NumaThreadPool = BasicThreadPool<detail::NumaQueue,
+                                       detail::Sync<std::mutex, std::condition_variable>,
+                                       detail::NumaThreadFactory<std::thread>>;
+
 }  // namespace pool_party
 
 #endif  // POOL_PARTY_THREAD_POOL_HPP_
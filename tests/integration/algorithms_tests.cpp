@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/algorithms.hpp"
+#include "pool_party/thread_pool.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class AlgorithmsTests : public testing::TestWithParam<pool_party::Chunking> {
+protected:
+    pool_party::ThreadPool m_pool{4};
+};
+
+INSTANTIATE_TEST_SUITE_P(Chunkings,
+                         AlgorithmsTests,
+                         testing::Values(pool_party::Chunking::static_size,
+                                         pool_party::Chunking::guided,
+                                         pool_party::Chunking::adaptive));
+
+TEST_P(AlgorithmsTests, ParallelForVisitsEachIndexOnce) {
+    std::vector<std::atomic_int> visits(10000);
+
+    pool_party::parallelFor(
+    m_pool, 0, 10000, [&visits](int index) { ++visits[static_cast<std::size_t>(index)]; }, GetParam());
+
+    for (const auto& visit : visits) {
+        EXPECT_THAT(visit.load(), testing::Eq(1));
+    }
+}
+
+TEST_P(AlgorithmsTests, ParallelForHonoursOffsetAndGrainSize) {
+    std::atomic_long sum{0};
+
+    pool_party::parallelFor(m_pool, -50L, 50L, [&sum](long index) { sum += index; }, GetParam(), 7);
+
+    EXPECT_THAT(sum.load(), testing::Eq(-50));
+}
+
+TEST_P(AlgorithmsTests, ParallelForWithEmptyRangeDoesNothing) {
+    std::atomic_int calls{0};
+
+    pool_party::parallelFor(m_pool, 5, 5, [&calls](int) { ++calls; }, GetParam());
+    pool_party::parallelFor(m_pool, 5, 3, [&calls](int) { ++calls; }, GetParam());
+
+    EXPECT_THAT(calls.load(), testing::Eq(0));
+}
+
+TEST_P(AlgorithmsTests, ParallelForRethrowsException) {
+    EXPECT_THROW(pool_party::parallelFor(
+                 m_pool,
+                 0,
+                 1000,
+                 [](int index) {
+                     if (index == 500) {
+                         throw std::runtime_error{"failed"};
+                     }
+                 },
+                 GetParam()),
+                 std::runtime_error);
+}
+
+TEST_P(AlgorithmsTests, NestedParallelForCompletes) {
+    pool_party::ThreadPool pool{2};
+    std::atomic_int visits{0};
+
+    pool_party::parallelFor(pool, 0, 8, [&pool, &visits](int) {
+        pool_party::parallelFor(pool, 0, 100, [&visits](int) { ++visits; }, GetParam());
+    });
+
+    EXPECT_THAT(visits.load(), testing::Eq(800));
+}
+
+TEST_P(AlgorithmsTests, ParallelReduceSumsAllElements) {
+    std::vector<long> values(100000);
+    std::iota(values.begin(), values.end(), 1L);
+
+    const auto sum{
+    pool_party::parallelReduce(m_pool, values.begin(), values.end(), 0L, std::plus<long>{}, GetParam())};
+
+    EXPECT_THAT(sum, testing::Eq(5000050000L));
+}
+
+TEST_P(AlgorithmsTests, ParallelReduceKeepsOrderOfNonCommutativeOperation) {
+    std::vector<std::string> letters{};
+    std::string expected{};
+    for (char letter{'a'}; letter <= 'z'; ++letter) {
+        letters.emplace_back(1, letter);
+        expected += letter;
+    }
+
+    const auto word{pool_party::parallelReduce(
+    m_pool, letters.begin(), letters.end(), std::string{">"}, std::plus<std::string>{}, GetParam())};
+
+    EXPECT_THAT(word, testing::Eq(">" + expected));
+}
+
+TEST_P(AlgorithmsTests, ParallelTransformReduceTransformsElements) {
+    const std::vector<int> values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    const auto sum_of_squares{pool_party::parallelTransformReduce(
+    m_pool, values.begin(), values.end(), 0, std::plus<int>{}, [](int value) { return value * value; }, GetParam())};
+
+    EXPECT_THAT(sum_of_squares, testing::Eq(385));
+}
+
+TEST_P(AlgorithmsTests, ParallelReduceOfEmptyRangeReturnsInit) {
+    const std::vector<int> values{};
+
+    EXPECT_THAT(pool_party::parallelReduce(m_pool, values.begin(), values.end(), 42, std::plus<int>{}, GetParam()),
+                testing::Eq(42));
+}
+
+class ScanTests : public testing::Test {
+protected:
+    pool_party::ThreadPool m_pool{4};
+};
+
+TEST_F(ScanTests, ParallelInclusiveScanMatchesSequentialScan) {
+    std::vector<long> values(10007);
+    std::iota(values.begin(), values.end(), 1L);
+    std::vector<long> expected(values.size());
+    std::partial_sum(values.begin(), values.end(), expected.begin());
+    std::vector<long> result(values.size());
+
+    const auto result_end{
+    pool_party::parallelInclusiveScan(m_pool, values.begin(), values.end(), result.begin(), std::plus<long>{})};
+
+    EXPECT_THAT(result_end, testing::Eq(result.end()));
+    EXPECT_THAT(result, testing::ContainerEq(expected));
+}
+
+TEST_F(ScanTests, ParallelInclusiveScanWorksInPlaceAndKeepsOrder) {
+    std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+
+    pool_party::parallelInclusiveScan(m_pool, words.begin(), words.end(), words.begin(), std::plus<std::string>{});
+
+    EXPECT_THAT(words, testing::ElementsAre("a", "ab", "abc", "abcd", "abcde", "abcdef", "abcdefg"));
+}
+
+TEST_F(ScanTests, ParallelInclusiveScanOfSingleElement) {
+    const std::vector<int> values{3};
+    std::vector<int> result(1);
+
+    pool_party::parallelInclusiveScan(m_pool, values.begin(), values.end(), result.begin(), std::plus<int>{});
+
+    EXPECT_THAT(result, testing::ElementsAre(3));
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/task_graph.hpp"
+#include "pool_party/thread_pool.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+class TaskGraphTests : public testing::Test {
+protected:
+    pool_party::ThreadPool m_pool{4};
+    pool_party::TaskGraph m_graph{};
+    std::mutex m_order_mtx{};
+    std::vector<int> m_order{};
+
+    pool_party::TaskGraph::NodeId addRecordingNode(int id) {
+        return m_graph.addNode([this, id]() {
+            std::lock_guard<std::mutex> lg{m_order_mtx};
+            m_order.push_back(id);
+        });
+    }
+
+    std::size_t positionOf(int id) const {
+        return static_cast<std::size_t>(std::find(m_order.begin(), m_order.end(), id) - m_order.begin());
+    }
+};
+
+TEST_F(TaskGraphTests, NodesRunAfterTheirPredecessors) {
+    const auto source{addRecordingNode(0)};
+    const auto left{addRecordingNode(1)};
+    const auto right{addRecordingNode(2)};
+    const auto sink{addRecordingNode(3)};
+    m_graph.addEdge(source, left);
+    m_graph.addEdge(source, right);
+    m_graph.addEdge(left, sink);
+    m_graph.addEdge(right, sink);
+
+    m_graph.submit(m_pool).get();
+
+    ASSERT_THAT(m_order, testing::UnorderedElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(positionOf(0), testing::Lt(positionOf(1)));
+    EXPECT_THAT(positionOf(0), testing::Lt(positionOf(2)));
+    EXPECT_THAT(positionOf(1), testing::Lt(positionOf(3)));
+    EXPECT_THAT(positionOf(2), testing::Lt(positionOf(3)));
+}
+
+TEST_F(TaskGraphTests, GraphIsReusableAcrossRuns) {
+    std::atomic_int executions{0};
+    auto previous{m_graph.addNode([&executions]() { ++executions; })};
+    for (int i{0}; i < 50; ++i) {
+        const auto node{m_graph.addNode([&executions]() { ++executions; })};
+        m_graph.addEdge(previous, node);
+        previous = node;
+    }
+
+    for (int run{0}; run < 10; ++run) {
+        m_graph.submit(m_pool).get();
+    }
+
+    EXPECT_THAT(executions.load(), testing::Eq(510));
+}
+
+TEST_F(TaskGraphTests, ExceptionSkipsDependentNodesAndIsPassedToFuture) {
+    const auto failing{m_graph.addNode([]() { throw std::logic_error{"failed"}; })};
+    const auto dependent{addRecordingNode(1)};
+    m_graph.addEdge(failing, dependent);
+
+    EXPECT_THROW(m_graph.submit(m_pool).get(), std::logic_error);
+    EXPECT_TRUE(m_order.empty());
+}
+
+TEST_F(TaskGraphTests, EmptyGraphFinishesImmediately) {
+    EXPECT_THAT(m_graph.submit(m_pool).wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
+}
+
+TEST_F(TaskGraphTests, CycleIsRejected) {
+    const auto first{addRecordingNode(0)};
+    const auto second{addRecordingNode(1)};
+    m_graph.addEdge(first, second);
+    m_graph.addEdge(second, first);
+
+    EXPECT_THROW(m_graph.submit(m_pool), std::invalid_argument);
+    EXPECT_TRUE(m_order.empty());
+}
+
+TEST_F(TaskGraphTests, InvalidEdgesAreRejected) {
+    const auto node{addRecordingNode(0)};
+
+    EXPECT_THROW(m_graph.addEdge(node, node + 1), std::out_of_range);
+    EXPECT_THROW(m_graph.addEdge(node, node), std::invalid_argument);
+}
+
+TEST_F(TaskGraphTests, RunningGraphCantBeModifiedOrSubmitted) {
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    m_graph.addNode([released]() { released.wait(); });
+
+    auto finished{m_graph.submit(m_pool)};
+    EXPECT_THROW(m_graph.addNode([]() {}), std::logic_error);
+    EXPECT_THROW(m_graph.submit(m_pool), std::logic_error);
+
+    release.set_value();
+    finished.get();
+    EXPECT_NO_THROW(m_graph.addNode([]() {}));
+}
+
+TEST_F(TaskGraphTests, SubmitToShutDownPoolThrows) {
+    addRecordingNode(0);
+    m_pool.shutdown();
+
+    EXPECT_THROW(m_graph.submit(m_pool), std::runtime_error);
+    EXPECT_TRUE(m_order.empty());
+}
+
+TEST_F(TaskGraphTests, NodeDroppedByShutdownNowFailsTheRun) {
+    // Occupy all workers, so the nodes stay queued
+    std::vector<std::promise<void>> started(4);
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    for (auto& worker_started : started) {
+        m_pool.post([&worker_started, released]() {
+            worker_started.set_value();
+            released.wait();
+        });
+    }
+    for (auto& worker_started : started) {
+        worker_started.get_future().wait();
+    }
+
+    const auto first{addRecordingNode(0)};
+    const auto second{addRecordingNode(1)};
+    m_graph.addEdge(first, second);
+    auto finished{m_graph.submit(m_pool)};
+
+    auto tasks{m_pool.shutdownNow()};
+    release.set_value();
+    tasks.clear();
+
+    EXPECT_THROW(finished.get(), std::future_error);
+    EXPECT_TRUE(m_order.empty());
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/task_group.hpp"
+#include "pool_party/thread_pool.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+template<typename Pool>
+long fibonacci(Pool& pool, int n) {
+    if (n < 2) {
+        return n;
+    }
+
+    long first{0};
+    long second{0};
+    pool_party::TaskGroup<Pool> group{pool};
+    group.run([&pool, &first, n]() { first = fibonacci(pool, n - 1); });
+    group.run([&pool, &second, n]() { second = fibonacci(pool, n - 2); });
+    group.wait();
+    return first + second;
+}
+
+}  // namespace
+
+TEST(TaskGroupTests, RecursiveForkJoinCompletesOnSingleWorker) {
+    pool_party::ThreadPool pool{1};
+
+    EXPECT_THAT(fibonacci(pool, 18), testing::Eq(2584));
+}
+
+TEST(TaskGroupTests, RecursiveForkJoinCompletesWithWorkStealing) {
+    pool_party::WorkStealingThreadPool pool{2};
+
+    EXPECT_THAT(fibonacci(pool, 20), testing::Eq(6765));
+}
+
+TEST(TaskGroupTests, WaitFromWorkerDoesNotBlockPool) {
+    pool_party::ThreadPool pool{1};
+    std::atomic_int finished_tasks{0};
+
+    auto future{pool.enqueue([&pool, &finished_tasks]() {
+        pool_party::TaskGroup<pool_party::ThreadPool> group{pool};
+        for (int i{0}; i < 10; ++i) {
+            group.run([&finished_tasks]() { ++finished_tasks; });
+        }
+        group.wait();
+        return finished_tasks.load();
+    })};
+
+    EXPECT_THAT(future.get(), testing::Eq(10));
+}
+
+TEST(TaskGroupTests, WaitRethrowsFirstExceptionAndGroupIsReusable) {
+    pool_party::ThreadPool pool{2};
+    pool_party::TaskGroup<pool_party::ThreadPool> group{pool};
+    std::atomic_int finished_tasks{0};
+
+    group.run([]() { throw std::logic_error{"failed"}; });
+    group.run([&finished_tasks]() { ++finished_tasks; });
+    EXPECT_THROW(group.wait(), std::logic_error);
+    EXPECT_THAT(finished_tasks.load(), testing::Eq(1));
+
+    group.run([&finished_tasks]() { ++finished_tasks; });
+    EXPECT_NO_THROW(group.wait());
+    EXPECT_THAT(finished_tasks.load(), testing::Eq(2));
+}
+
+TEST(TaskGroupTests, DestructorWaitsForTasks) {
+    pool_party::ThreadPool pool{2};
+    std::atomic_int finished_tasks{0};
+
+    {
+        pool_party::TaskGroup<pool_party::ThreadPool> group{pool};
+        for (int i{0}; i < 20; ++i) {
+            group.run([&finished_tasks]() { ++finished_tasks; });
+        }
+    }
+
+    EXPECT_THAT(finished_tasks.load(), testing::Eq(20));
+}
+
+TEST(TaskGroupTests, RunAfterShutdownThrows) {
+    pool_party::ThreadPool pool{1};
+    pool_party::TaskGroup<pool_party::ThreadPool> group{pool};
+    pool.shutdown();
+
+    EXPECT_THROW(group.run([]() {}), std::runtime_error);
+    EXPECT_NO_THROW(group.wait());
+}
+
+TEST(TaskGroupTests, TasksDroppedByShutdownNowFinishTheGroup) {
+    pool_party::ThreadPool pool{1};
+    pool_party::TaskGroup<pool_party::ThreadPool> group{pool};
+    std::promise<void> started{};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    std::atomic_int finished_tasks{0};
+
+    group.run([&started, released]() {
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+    for (int i{0}; i < 5; ++i) {
+        group.run([&finished_tasks]() { ++finished_tasks; });
+    }
+
+    auto tasks{pool.shutdownNow()};
+    release.set_value();
+    EXPECT_THAT(tasks.size(), testing::Eq(5U));
+    tasks.clear();
+
+    EXPECT_THROW(group.wait(), std::future_error);
+    EXPECT_THAT(finished_tasks.load(), testing::Eq(0));
+}
@@ -20,14 +20,22 @@
  * SOFTWARE.
  */
 
+#include "pool_party/combinators.hpp"
 #include "pool_party/thread_pool.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 class IntegrationTests : public testing::Test {
 protected:
@@ -68,4 +76,631 @@ TEST_F(IntegrationTests, ShutdownThreadPoolAutomatically) {
     EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
 }
 
+TEST_F(IntegrationTests, HandleAllPostedTasks) {
+    const int test_task_count{50};
+    std::atomic_int handled_tasks{0};
+    std::atomic_int handled_exceptions{0};
+
+    {
+        pool_party::ThreadPool pool{4};
+        pool.setExceptionHandler([&handled_exceptions](std::exception_ptr) { ++handled_exceptions; });
+        for (int i{0}; i < test_task_count; ++i) {
+            pool.post(
+            [&handled_tasks](int task_index) {
+                ++handled_tasks;
+                if (task_index % 2 == 0) {
+                    throw std::runtime_error{"Even task failed"};
+                }
+            },
+            i);
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+    EXPECT_THAT(handled_exceptions, testing::Eq(test_task_count / 2));
+}
+
+TEST_F(IntegrationTests, WorkStealingPoolHandlesAllTasks) {
+    const int test_task_count{50};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::WorkStealingThreadPool pool{4};
+        for (int i{0}; i < test_task_count; ++i) {
+            pool.enqueue([&handled_tasks]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds{5});
+                ++handled_tasks;
+            });
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, WorkStealingPoolHandlesTasksEnqueuedByTasks) {
+    const int test_task_count{1000};
+    const int subtask_count{10};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::WorkStealingThreadPool pool{4};
+        std::vector<std::future<void>> futures{};
+        for (int i{0}; i < test_task_count; ++i) {
+            futures.push_back(pool.enqueue([&pool, &handled_tasks]() {
+                for (int j{0}; j < subtask_count; ++j) {
+                    pool.enqueue([&handled_tasks]() { ++handled_tasks; });
+                }
+            }));
+        }
+
+        // Subtasks can only be enqueued until the pool is shut down
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count * subtask_count));
+}
+
+TEST_F(IntegrationTests, RingBufferPoolHandlesMoreTasksThanItsCapacity) {
+    const int test_task_count{1000};
+    const std::size_t capacity{16};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::RingBufferThreadPool pool{4, capacity};
+        for (int i{0}; i < test_task_count; ++i) {
+            pool.enqueue([&handled_tasks]() { ++handled_tasks; });
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, BulkEnqueuedTasksAreHandledByEveryScheduler) {
+    const std::size_t test_task_count{1000};
+    const auto square{[](std::size_t task_index) { return task_index * task_index; }};
+
+    pool_party::ThreadPool fifo_pool{4};
+    pool_party::WorkStealingThreadPool work_stealing_pool{4};
+    pool_party::RingBufferThreadPool ring_buffer_pool{4, 64};
+    auto fifo_futures{fifo_pool.enqueueBulk(test_task_count, square)};
+    auto work_stealing_futures{work_stealing_pool.enqueueBulk(test_task_count, square)};
+    auto ring_buffer_futures{ring_buffer_pool.enqueueBulk(test_task_count, square)};
+
+    for (std::size_t task_index{0}; task_index < test_task_count; ++task_index) {
+        EXPECT_THAT(fifo_futures[task_index].get(), testing::Eq(square(task_index)));
+        EXPECT_THAT(work_stealing_futures[task_index].get(), testing::Eq(square(task_index)));
+        EXPECT_THAT(ring_buffer_futures[task_index].get(), testing::Eq(square(task_index)));
+    }
+}
+
+TEST_F(IntegrationTests, SpinningPoolHandlesAllTasks) {
+    const int test_task_count{1000};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::SpinningThreadPool<> pool{4};
+        pool.setSpinBudget(100);
+        for (int i{0}; i < test_task_count; ++i) {
+            pool.post([&handled_tasks]() { ++handled_tasks; });
+            if (i % 100 == 0) {
+                // Let the workers run out of work to exercise spinning and parking
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, PinnedPoolHandlesAllTasks) {
+    const int test_task_count{1000};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::PinnedThreadPool<> compact_pool{4};
+        pool_party::PinnedThreadPool<> scatter_pool{
+        4, pool_party::detail::PinnedThreadFactory<std::thread>{pool_party::detail::CpuPlacement::scatter}};
+        for (int i{0}; i < test_task_count; ++i) {
+            auto& pool{i % 2 == 0 ? compact_pool : scatter_pool};
+            pool.post([&handled_tasks]() { ++handled_tasks; });
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, NumaPoolHandlesTasksOfAllNodes) {
+    const int test_task_count{1000};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::NumaThreadPool pool{4};
+        const auto nodes{pool_party::detail::readNumaTopology()};
+        for (int i{0}; i < test_task_count; ++i) {
+            const auto& node{nodes[static_cast<std::size_t>(i) % nodes.size()]};
+            pool.postOn(node.id, [&handled_tasks]() { ++handled_tasks; });
+            pool.post([&handled_tasks]() { ++handled_tasks; });
+        }
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(2 * test_task_count));
+}
+
+TEST_F(IntegrationTests, PriorityPoolHandlesTasksOfAllPriorities) {
+    const int test_task_count{1000};
+    const pool_party::Priority priorities[]{pool_party::Priority::low, pool_party::Priority::normal,
+                                            pool_party::Priority::high, pool_party::Priority::critical};
+    std::atomic_int handled_tasks{0};
+
+    {
+        pool_party::PriorityThreadPool pool{4, 16};
+        for (int i{0}; i < test_task_count; ++i) {
+            pool.post(priorities[i % 4], [&handled_tasks]() { ++handled_tasks; });
+        }
+        EXPECT_THAT(pool.enqueue(pool_party::Priority::critical, []() { return 42; }).get(), testing::Eq(42));
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, ContinuationsOfSubmittedTasksRunOnPool) {
+    const int test_task_count{200};
+    std::atomic_int handled_continuations{0};
+
+    {
+        pool_party::WorkStealingThreadPool pool{4};
+        std::vector<pool_party::Future<int>> futures{};
+        for (int i{0}; i < test_task_count; ++i) {
+            futures.push_back(pool.submit([i]() { return i; }).then([&handled_continuations](int value) {
+                ++handled_continuations;
+                return 2 * value;
+            }));
+        }
+
+        int sum{0};
+        for (auto& future : futures) {
+            sum += future.get();
+        }
+        EXPECT_THAT(sum, testing::Eq(test_task_count * (test_task_count - 1)));
+    }
+
+    EXPECT_THAT(handled_continuations, testing::Eq(test_task_count));
+}
+
+TEST_F(IntegrationTests, ContinuationRunsWhenPoolShutsDownBeforeResult) {
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    pool_party::Future<int> continued{};
+
+    {
+        pool_party::ThreadPool pool{1};
+        continued = pool.submit([released]() {
+                            released.wait();
+                            return 1;
+                        }).then([](int value) { return value + 1; });
+        pool.shutdown();
+        release.set_value();
+    }
+
+    EXPECT_THAT(continued.get(), testing::Eq(2));
+}
+
+TEST_F(IntegrationTests, CombinedFuturesOfSubmittedTasks) {
+    pool_party::ThreadPool pool{4};
+    std::vector<pool_party::Future<int>> futures{};
+    for (int i{1}; i <= 100; ++i) {
+        futures.push_back(pool.submit([i]() { return i; }));
+    }
+
+    auto sum{pool_party::whenAll(std::move(futures)).then([](std::vector<int> values) {
+        int result{0};
+        for (const auto value : values) {
+            result += value;
+        }
+        return result;
+    })};
+    EXPECT_THAT(sum.get(), testing::Eq(5050));
+
+    std::vector<pool_party::Future<void>> racing{};
+    racing.push_back(pool.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds{100}); }));
+    racing.push_back(pool.submit([]() {}));
+    EXPECT_THAT(pool_party::whenAny(std::move(racing)).get().index, testing::Eq(1U));
+}
+
+TEST_F(IntegrationTests, ElasticPoolGrowsUnderBacklogAndShrinksWhenIdle) {
+    const int test_task_count{8};
+    std::atomic_int handled_tasks{0};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+
+    pool_party::ThreadPool pool{pool_party::ElasticLimits{1, 4, std::chrono::milliseconds{20}}};
+    EXPECT_THAT(pool.getNumberOfThreads(), testing::Eq(1U));
+
+    std::atomic_int started_tasks{0};
+    for (int i{0}; i < test_task_count; ++i) {
+        pool.post([&started_tasks, &handled_tasks, released]() {
+            ++started_tasks;
+            released.wait();
+            ++handled_tasks;
+        });
+
+        // Each blocked task occupies a worker, the next push finds no idle worker then
+        while (i < 4 && started_tasks <= i) {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_THAT(pool.getNumberOfThreads(), testing::Eq(4U));
+
+    release.set_value();
+    const auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds{5}};
+    while (pool.getNumberOfThreads() > 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(test_task_count));
+    EXPECT_THAT(pool.getNumberOfThreads(), testing::Eq(1U));
+    EXPECT_THAT(pool.enqueue([]() { return 42; }).get(), testing::Eq(42));
+}
+
+TEST_F(IntegrationTests, HillClimbingControllerReportsDecisionsWithinLimits) {
+    std::mutex decisions_mtx{};
+    std::vector<pool_party::ConcurrencyDecision> decisions{};
+    pool_party::ElasticLimits limits{1, 4};
+    limits.control_interval = std::chrono::milliseconds{5};
+    pool_party::ThreadPool pool{limits};
+
+    pool.setConcurrencyObserver([&decisions_mtx, &decisions](const pool_party::ConcurrencyDecision& decision) {
+        std::lock_guard<std::mutex> lg{decisions_mtx};
+        decisions.push_back(decision);
+    });
+
+    std::atomic_int handled_tasks{0};
+    int posted_tasks{0};
+    const auto deadline{std::chrono::steady_clock::now() + std::chrono::milliseconds{200}};
+    while (std::chrono::steady_clock::now() < deadline) {
+        pool.postBulk(64, [&handled_tasks](std::size_t) {
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+            ++handled_tasks;
+        });
+        posted_tasks += 64;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    pool.shutdown();
+
+    // Decisions are only taken after completed tasks
+    while (handled_tasks < posted_tasks) {
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lg{decisions_mtx};
+    ASSERT_THAT(decisions, testing::Not(testing::IsEmpty()));
+    EXPECT_THAT(decisions.front().previous_target, testing::Eq(1U));
+    EXPECT_THAT(decisions.front().reason, testing::Eq(pool_party::ConcurrencyReason::baseline_measured));
+    for (std::size_t index{0}; index < decisions.size(); ++index) {
+        EXPECT_THAT(decisions[index].target, testing::AllOf(testing::Ge(1U), testing::Le(4U)));
+        if (index > 0) {
+            EXPECT_THAT(decisions[index].previous_target, testing::Eq(decisions[index - 1].target));
+        }
+    }
+    EXPECT_THAT(pool.getWorkerTarget(), testing::Eq(decisions.back().target));
+    EXPECT_THAT(pool.getNumberOfThreads(), testing::Le(4U));
+}
+
+TEST_F(IntegrationTests, BoundedQueueBlocksProducersUntilSlotIsFree) {
+    const std::size_t capacity{2};
+    pool_party::ThreadPool pool{1, capacity};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    std::promise<void> started{};
+
+    // The worker is blocked by the first task, the next two tasks fill the queue
+    pool.post([&started, released]() {
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+    pool.post([]() {});
+    pool.post([]() {});
+
+    EXPECT_FALSE(pool.tryEnqueue([]() { return 0; }).valid());
+    EXPECT_FALSE(pool.enqueueFor(std::chrono::milliseconds{10}, []() { return 0; }).valid());
+
+    auto blocked_producer{std::async(std::launch::async, [&pool]() { return pool.enqueue([]() { return 42; }); })};
+    EXPECT_THAT(blocked_producer.wait_for(std::chrono::milliseconds{20}), testing::Eq(std::future_status::timeout));
+
+    release.set_value();
+    EXPECT_THAT(blocked_producer.get().get(), testing::Eq(42));
+    EXPECT_THAT(pool.enqueueFor(std::chrono::seconds{5}, []() { return 1; }).get(), testing::Eq(1));
+}
+
+TEST_F(IntegrationTests, ShutdownWakesProducerWaitingForFreeSlot) {
+    pool_party::RingBufferThreadPool pool{1, 2};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+
+    auto blocked_producer{std::async(std::launch::async, [&pool, released]() {
+        while (true) {
+            pool.post([released]() { released.wait(); });
+        }
+    })};
+    EXPECT_THAT(blocked_producer.wait_for(std::chrono::milliseconds{20}), testing::Eq(std::future_status::timeout));
+
+    pool.shutdown();
+    EXPECT_THROW(blocked_producer.get(), std::runtime_error);
+    release.set_value();
+}
+
+TEST_F(IntegrationTests, FollowUpTasksRunOnSpawningWorker) {
+    const int chain_length{1000};
+    pool_party::LifoSlotThreadPool pool{4};
+    std::vector<std::thread::id> executing_threads(chain_length);
+    std::promise<void> done{};
+
+    std::function<void(int)> hop{};
+    hop = [&pool, &hop, &executing_threads, &done](int index) {
+        executing_threads[static_cast<std::size_t>(index)] = std::this_thread::get_id();
+        if (index + 1 == chain_length) {
+            done.set_value();
+            return;
+        }
+        pool.post(hop, index + 1);
+    };
+    pool.post(hop, 0);
+    done.get_future().wait();
+
+    // Idle workers only steal follow-ups which waited too long, e.g. while the worker was preempted
+    int same_thread_hops{0};
+    for (std::size_t index{2}; index < executing_threads.size(); ++index) {
+        same_thread_hops += executing_threads[index] == executing_threads[index - 1] ? 1 : 0;
+    }
+    EXPECT_THAT(same_thread_hops, testing::Gt(chain_length / 2));
+}
+
+TEST_F(IntegrationTests, StrandTasksRunInOrderAndNeverInParallel) {
+    const int key_count{8};
+    const int producer_count{4};
+    const int tasks_per_key{250};
+    std::vector<std::vector<int>> executed_tasks(key_count);
+    std::vector<std::atomic_int> running_tasks(key_count);
+    std::atomic_int overlapping_tasks{0};
+
+    {
+        pool_party::ThreadPool pool{8};
+        std::vector<std::thread> producers{};
+        for (int producer{0}; producer < producer_count; ++producer) {
+            producers.emplace_back([&, producer]() {
+                for (int task{0}; task < tasks_per_key; ++task) {
+                    for (int key{0}; key < key_count; ++key) {
+                        const auto index{static_cast<std::size_t>(key)};
+                        pool.post(pool_party::StrandKey{index}, [&, index, producer, task]() {
+                            overlapping_tasks += ++running_tasks[index] == 1 ? 0 : 1;
+                            executed_tasks[index].push_back(producer * tasks_per_key + task);
+                            --running_tasks[index];
+                        });
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+    }
+
+    EXPECT_THAT(overlapping_tasks, testing::Eq(0));
+    for (const auto& tasks : executed_tasks) {
+        ASSERT_THAT(tasks.size(), testing::Eq(static_cast<std::size_t>(producer_count * tasks_per_key)));
+        // Tasks of the same producer keep their order, tasks of different producers interleave
+        std::vector<int> next_tasks(producer_count, 0);
+        for (const auto task : tasks) {
+            auto& next_task{next_tasks[static_cast<std::size_t>(task / tasks_per_key)]};
+            EXPECT_THAT(task % tasks_per_key, testing::Eq(next_task));
+            next_task = task % tasks_per_key + 1;
+        }
+    }
+}
+
+TEST_F(IntegrationTests, DifferentStrandsRunInParallel) {
+    pool_party::ThreadPool pool{2};
+    std::promise<void> second_started{};
+
+    auto first{pool.enqueue(pool_party::StrandKey{1}, [&second_started]() {
+        return second_started.get_future().wait_for(std::chrono::seconds{5});
+    })};
+    pool.enqueue(pool_party::StrandKey{2}, [&second_started]() { second_started.set_value(); });
+
+    EXPECT_THAT(first.get(), testing::Eq(std::future_status::ready));
+}
+
+TEST_F(IntegrationTests, ScheduledTaskRunsAfterDelayWithoutOccupyingWorker) {
+    pool_party::ThreadPool pool{1};
+    std::promise<std::chrono::steady_clock::time_point> fired{};
+    const auto delay{std::chrono::milliseconds{50}};
+
+    const auto scheduled_at{std::chrono::steady_clock::now()};
+    pool.scheduleAfter(delay, [&fired]() { fired.set_value(std::chrono::steady_clock::now()); });
+    auto fired_at{fired.get_future()};
+
+    // The single worker stays free for other tasks while the timer is pending
+    EXPECT_THAT(pool.enqueue([]() { return 1; }).get(), testing::Eq(1));
+    EXPECT_THAT(fired_at.wait_for(std::chrono::milliseconds{0}), testing::Eq(std::future_status::timeout));
+    EXPECT_THAT(fired_at.get() - scheduled_at, testing::Ge(delay));
+}
+
+TEST_F(IntegrationTests, PeriodicTaskRunsUntilCancelled) {
+    pool_party::ThreadPool pool{2};
+    std::atomic_int runs{0};
+
+    const auto id{pool.scheduleEvery(std::chrono::milliseconds{2}, [&runs]() { ++runs; })};
+    while (runs < 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    EXPECT_TRUE(pool.cancelTimer(id));
+    EXPECT_FALSE(pool.cancelTimer(id));
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    const int runs_after_cancel{runs};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_THAT(runs.load(), testing::Eq(runs_after_cancel));
+}
+
+TEST_F(IntegrationTests, CancelledTimerDoesNotRun) {
+    pool_party::ThreadPool pool{2};
+    std::atomic_bool has_run{false};
+
+    const auto id{pool.scheduleAt(std::chrono::steady_clock::now() + std::chrono::milliseconds{20},
+                                  [&has_run]() { has_run = true; })};
+    EXPECT_TRUE(pool.cancelTimer(id));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{40});
+    EXPECT_FALSE(has_run);
+}
+
+TEST_F(IntegrationTests, ShutdownDropsPendingTimers) {
+    std::atomic_bool has_run{false};
+    {
+        pool_party::ThreadPool pool{2};
+        pool.scheduleAfter(std::chrono::hours{1}, [&has_run]() { has_run = true; });
+        pool.shutdown();
+        EXPECT_THROW(pool.scheduleAfter(std::chrono::milliseconds{1}, []() {}), std::runtime_error);
+    }
+    EXPECT_FALSE(has_run);
+}
+
+TEST_F(IntegrationTests, ShutdownNowHandsBackQueuedTasks) {
+    const int queued_task_count{10};
+    std::atomic_int handled_tasks{0};
+    std::vector<pool_party::Task> tasks{};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+
+    {
+        pool_party::ThreadPool pool{1};
+        std::promise<void> started{};
+        pool.post([&started, released]() {
+            started.set_value();
+            released.wait();
+        });
+        started.get_future().wait();
+        for (int i{0}; i < queued_task_count; ++i) {
+            pool.post([&handled_tasks]() { ++handled_tasks; });
+        }
+
+        tasks = pool.shutdownNow();
+        release.set_value();
+    }
+
+    EXPECT_THAT(handled_tasks, testing::Eq(0));
+    ASSERT_THAT(tasks.size(), testing::Eq(static_cast<std::size_t>(queued_task_count)));
+    for (auto& task : tasks) {
+        task();
+    }
+    EXPECT_THAT(handled_tasks, testing::Eq(queued_task_count));
+}
+
+TEST_F(IntegrationTests, ShutdownNowReturnsWhileTasksRunAndWaitIdleWaitsForThem) {
+    pool_party::ThreadPool pool{1};
+    std::promise<void> started{};
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    std::atomic_bool is_finished{false};
+    pool.post([&started, &is_finished, released]() {
+        started.set_value();
+        released.wait();
+        is_finished = true;
+    });
+    started.get_future().wait();
+    pool.post([]() {});
+
+    EXPECT_THAT(pool.shutdownNow().size(), testing::Eq(1U));
+    EXPECT_FALSE(pool.waitIdleFor(std::chrono::milliseconds{0}));
+
+    release.set_value();
+    pool.waitIdle();
+    EXPECT_TRUE(is_finished);
+}
+
+TEST_F(IntegrationTests, ShutdownForBoundsTheDrain) {
+    std::atomic_int handled_tasks{0};
+    pool_party::WorkStealingThreadPool pool{2};
+    for (int i{0}; i < 100; ++i) {
+        pool.post([&handled_tasks]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            ++handled_tasks;
+        });
+    }
+
+    const auto start{std::chrono::steady_clock::now()};
+    const auto tasks{pool.shutdownFor(std::chrono::milliseconds{20})};
+    EXPECT_THAT(std::chrono::steady_clock::now() - start, testing::Lt(std::chrono::seconds{1}));
+    EXPECT_FALSE(tasks.empty());
+    EXPECT_THAT(tasks.size() + static_cast<std::size_t>(handled_tasks.load()), testing::Le(100U));
+}
+
+TEST_F(IntegrationTests, ShutdownForReturnsNothingWhenDrainedInTime) {
+    std::atomic_int handled_tasks{0};
+    pool_party::ThreadPool pool{4};
+    for (int i{0}; i < 20; ++i) {
+        pool.post([&handled_tasks]() { ++handled_tasks; });
+    }
+
+    EXPECT_TRUE(pool.shutdownFor(std::chrono::seconds{10}).empty());
+    EXPECT_THAT(handled_tasks, testing::Eq(20));
+}
+
+TEST_F(IntegrationTests, CancelRunningAndQueuedTasks) {
+    const int queued_task_count{10};
+    std::atomic_int handled_tasks{0};
+    pool_party::CancellationSource source{};
+    std::promise<void> started{};
+    pool_party::ThreadPool pool{1};
+
+    const auto token{source.getToken()};
+    auto running{pool.enqueue(token, [&started, token]() {
+        started.set_value();
+        while (!token.isCancelled()) {
+            std::this_thread::yield();
+        }
+        token.throwIfCancelled();
+    })};
+    std::vector<std::future<void>> queued{};
+    for (int i{0}; i < queued_task_count; ++i) {
+        queued.push_back(pool.enqueue(source.getToken(), [&handled_tasks]() { ++handled_tasks; }));
+    }
+    started.get_future().wait();
+    source.cancel();
+
+    EXPECT_THROW(running.get(), pool_party::TaskCancelled);
+    for (auto& future : queued) {
+        EXPECT_THROW(future.get(), pool_party::TaskCancelled);
+    }
+    EXPECT_THAT(handled_tasks, testing::Eq(0));
+}
+
+TEST_F(IntegrationTests, WaitIdleSeparatesPhases) {
+    const int tasks_per_phase{1000};
+    std::atomic_int handled_tasks{0};
+    pool_party::ThreadPool pool{4};
+
+    for (int phase{1}; phase <= 3; ++phase) {
+        for (int i{0}; i < tasks_per_phase; ++i) {
+            pool.post([&handled_tasks]() { ++handled_tasks; });
+        }
+        pool.waitIdle();
+        EXPECT_THAT(handled_tasks, testing::Eq(phase * tasks_per_phase));
+    }
+}
+
+TEST_F(IntegrationTests, WaitIdleForTimesOutWhileTaskRuns) {
+    std::promise<void> release{};
+    auto released{release.get_future().share()};
+    pool_party::WorkStealingThreadPool pool{2};
+    pool.post([released]() { released.wait(); });
+
+    EXPECT_FALSE(pool.waitIdleFor(std::chrono::milliseconds{20}));
+    release.set_value();
+    EXPECT_TRUE(pool.waitIdleFor(std::chrono::seconds{10}));
+}
+
 // TODO Add test pool auto shutdown mechanism
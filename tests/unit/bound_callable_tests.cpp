@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/bound_callable.hpp"
+#include "pool_party/detail/task.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+using pool_party::detail::bindArguments;
+using testing::Eq;
+
+namespace {
+class Counter {
+public:
+    int add(int value) {
+        m_count += value;
+        return m_count;
+    }
+
+private:
+    int m_count{0};
+};
+}  // namespace
+
+class BoundCallableTests : public testing::Test {};
+
+TEST_F(BoundCallableTests, CallableWithoutArgumentsIsStoredAsIs) {
+    auto callable{bindArguments([]() { return 42; })};
+    EXPECT_THAT(callable(), Eq(42));
+}
+
+TEST_F(BoundCallableTests, ArgumentsArePassedToTheCallable) {
+    auto callable{bindArguments([](int lhs, const std::string& rhs) { return std::to_string(lhs) + rhs; }, 4, "2")};
+    EXPECT_THAT(callable(), Eq("42"));
+}
+
+TEST_F(BoundCallableTests, ArgumentsAreStoredAsCopies) {
+    int value{1};
+    auto callable{bindArguments([](int& stored) { return ++stored; }, value)};
+    EXPECT_THAT(callable(), Eq(2));
+    EXPECT_THAT(callable(), Eq(3));
+    EXPECT_THAT(value, Eq(1));
+}
+
+TEST_F(BoundCallableTests, MoveOnlyArgumentsAreMovedIn) {
+    auto callable{bindArguments([](std::unique_ptr<int>& stored) { return *stored; }, std::make_unique<int>(42))};
+    EXPECT_THAT(callable(), Eq(42));
+}
+
+TEST_F(BoundCallableTests, MemberFunctionIsCalledOnTheObject) {
+    Counter counter{};
+    auto callable{bindArguments(&Counter::add, &counter, 42)};
+    EXPECT_THAT(callable(), Eq(42));
+    EXPECT_THAT(counter.add(0), Eq(42));
+}
+
+TEST_F(BoundCallableTests, SmallBoundCallableIsStoredInline) {
+    auto callable{bindArguments([](int lhs, int rhs) { return lhs + rhs; }, 4, 2)};
+    EXPECT_TRUE(pool_party::detail::Task::isStoredInline<decltype(callable)>());
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/cache_line.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+using pool_party::detail::CacheAlignedAllocator;
+using pool_party::detail::cache_line_size;
+using testing::Eq;
+
+namespace {
+struct alignas(cache_line_size) PaddedCounter {
+    std::size_t value{0};
+};
+}  // namespace
+
+TEST(CacheAlignedAllocatorTests, ElementsStartAtCacheLines) {
+    for (std::size_t size{1}; size <= 16; ++size) {
+        std::vector<PaddedCounter, CacheAlignedAllocator<PaddedCounter>> counters(size);
+        for (const auto& counter : counters) {
+            EXPECT_THAT(reinterpret_cast<std::uintptr_t>(&counter) % cache_line_size, Eq(0U));
+        }
+    }
+}
+
+TEST(CacheAlignedAllocatorTests, OversizedAllocationThrows) {
+    CacheAlignedAllocator<PaddedCounter> allocator{};
+    EXPECT_THROW(allocator.allocate(std::numeric_limits<std::size_t>::max() / sizeof(PaddedCounter)), std::bad_alloc);
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/cancellation.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::Eq;
+
+TEST(CancellationTests, DefaultTokenIsNeverCancelled) {
+    pool_party::detail::CancellationToken token{};
+    EXPECT_FALSE(token.isCancelled());
+    EXPECT_NO_THROW(token.throwIfCancelled());
+}
+
+TEST(CancellationTests, SourceCancelsAllOfItsTokens) {
+    pool_party::detail::CancellationSource source{};
+    auto first{source.getToken()};
+    auto second{source.getToken()};
+    EXPECT_FALSE(source.isCancelled());
+    EXPECT_FALSE(first.isCancelled());
+
+    source.cancel();
+    EXPECT_TRUE(source.isCancelled());
+    EXPECT_TRUE(first.isCancelled());
+    EXPECT_TRUE(second.isCancelled());
+    EXPECT_THROW(first.throwIfCancelled(), pool_party::detail::TaskCancelled);
+}
+
+TEST(CancellationTests, TokenOutlivesItsSource) {
+    pool_party::detail::CancellationToken token{};
+    {
+        pool_party::detail::CancellationSource source{};
+        token = source.getToken();
+        source.cancel();
+    }
+    EXPECT_TRUE(token.isCancelled());
+}
+
+TEST(CancellationTests, CallableRunsWhileNotCancelled) {
+    pool_party::detail::CancellationSource source{};
+    auto callable{[]() { return 42; }};
+    pool_party::detail::CancellableCallable<decltype(callable)> cancellable{source.getToken(), std::move(callable)};
+    EXPECT_THAT(cancellable(), Eq(42));
+}
+
+TEST(CancellationTests, CancelledCallableIsSkipped) {
+    pool_party::detail::CancellationSource source{};
+    bool executed{false};
+    auto callable{[&executed]() { executed = true; }};
+    pool_party::detail::CancellableCallable<decltype(callable)> cancellable{source.getToken(), std::move(callable)};
+
+    source.cancel();
+    EXPECT_THROW(cancellable(), pool_party::detail::TaskCancelled);
+    EXPECT_FALSE(executed);
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/chase_lev_deque.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using testing::Eq;
+
+class ChaseLevDequeTests : public testing::Test {
+protected:
+    pool_party::detail::ChaseLevDeque<int> m_deque{2};
+};
+
+TEST_F(ChaseLevDequeTests, PopFromEmptyDequeFails) {
+    int item{0};
+    EXPECT_FALSE(m_deque.pop(item));
+    EXPECT_FALSE(m_deque.steal(item));
+    EXPECT_TRUE(m_deque.empty());
+}
+
+TEST_F(ChaseLevDequeTests, OwnerPopsInLifoOrder) {
+    m_deque.push(1);
+    m_deque.push(2);
+
+    int item{0};
+    ASSERT_TRUE(m_deque.pop(item));
+    EXPECT_THAT(item, Eq(2));
+    ASSERT_TRUE(m_deque.pop(item));
+    EXPECT_THAT(item, Eq(1));
+}
+
+TEST_F(ChaseLevDequeTests, ThievesStealInFifoOrder) {
+    m_deque.push(1);
+    m_deque.push(2);
+
+    int item{0};
+    ASSERT_TRUE(m_deque.steal(item));
+    EXPECT_THAT(item, Eq(1));
+    ASSERT_TRUE(m_deque.steal(item));
+    EXPECT_THAT(item, Eq(2));
+}
+
+TEST_F(ChaseLevDequeTests, GrowWhenCapacityIsExceeded) {
+    const int item_count{100};
+    for (int i{0}; i < item_count; ++i) {
+        m_deque.push(i);
+    }
+    EXPECT_THAT(m_deque.size(), Eq(static_cast<std::size_t>(item_count)));
+
+    int item{0};
+    for (int i{item_count - 1}; i >= 0; --i) {
+        ASSERT_TRUE(m_deque.pop(item));
+        EXPECT_THAT(item, Eq(i));
+    }
+}
+
+TEST_F(ChaseLevDequeTests, EachItemIsTakenExactlyOnceWhileStealing) {
+    const int item_count{100000};
+    const int thief_count{3};
+    std::vector<std::atomic_int> taken(item_count);
+    std::atomic_bool owner_done{false};
+
+    std::vector<std::thread> thieves{};
+    for (int i{0}; i < thief_count; ++i) {
+        thieves.emplace_back([this, &taken, &owner_done]() {
+            int item{0};
+            while (!owner_done || !m_deque.empty()) {
+                if (m_deque.steal(item)) {
+                    ++taken[static_cast<std::size_t>(item)];
+                }
+            }
+        });
+    }
+
+    int item{0};
+    for (int i{0}; i < item_count; ++i) {
+        m_deque.push(i);
+        if (i % 3 == 0 && m_deque.pop(item)) {
+            ++taken[static_cast<std::size_t>(item)];
+        }
+    }
+    while (m_deque.pop(item)) {
+        ++taken[static_cast<std::size_t>(item)];
+    }
+    owner_done = true;
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (const auto& count : taken) {
+        EXPECT_THAT(count.load(), Eq(1));
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/combinators.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using pool_party::detail::Future;
+using testing::ElementsAre;
+using testing::Eq;
+
+class CombinatorsTests : public testing::Test {
+protected:
+    using StateType = Future<std::string>::StateType;
+
+    std::vector<std::shared_ptr<StateType>> m_states{};
+
+    std::vector<Future<std::string>> makeFutures(std::size_t number_of_futures) {
+        std::vector<Future<std::string>> futures{};
+        for (std::size_t index{0}; index < number_of_futures; ++index) {
+            m_states.push_back(std::make_shared<StateType>(nullptr, nullptr));
+            futures.emplace_back(m_states.back());
+        }
+        return futures;
+    }
+};
+
+TEST_F(CombinatorsTests, WhenAllWaitsForLastFutureAndKeepsOrder) {
+    auto all{pool_party::whenAll(makeFutures(3))};
+
+    m_states[2]->setValue("c");
+    m_states[0]->setValue("a");
+    EXPECT_FALSE(all.isReady());
+    m_states[1]->setValue("b");
+
+    ASSERT_TRUE(all.isReady());
+    EXPECT_THAT(all.get(), ElementsAre("a", "b", "c"));
+}
+
+TEST_F(CombinatorsTests, WhenAllPassesOnFirstException) {
+    auto all{pool_party::whenAll(makeFutures(3))};
+
+    m_states[0]->setValue("a");
+    m_states[2]->setException(std::make_exception_ptr(std::out_of_range{"second"}));
+    m_states[1]->setException(std::make_exception_ptr(std::logic_error{"first"}));
+
+    EXPECT_THROW(all.get(), std::logic_error);
+}
+
+TEST_F(CombinatorsTests, WhenAllOfNoFuturesIsReady) {
+    auto all{pool_party::whenAll(std::vector<Future<int>>{})};
+
+    ASSERT_TRUE(all.isReady());
+    EXPECT_TRUE(all.get().empty());
+}
+
+TEST_F(CombinatorsTests, WhenAllOfVoidFutures) {
+    auto state{std::make_shared<Future<void>::StateType>(nullptr, nullptr)};
+    std::vector<Future<void>> futures{};
+    futures.emplace_back(state);
+    auto all{pool_party::whenAll(std::move(futures))};
+
+    EXPECT_FALSE(all.isReady());
+    state->setValue();
+    EXPECT_TRUE(all.isReady());
+}
+
+TEST_F(CombinatorsTests, WhenAnyPublishesFirstFinishedFuture) {
+    auto any{pool_party::whenAny(makeFutures(3))};
+
+    m_states[1]->setValue("b");
+    m_states[0]->setValue("a");
+
+    const auto result{any.get()};
+    EXPECT_THAT(result.index, Eq(1U));
+    EXPECT_THAT(result.value, Eq("b"));
+}
+
+TEST_F(CombinatorsTests, WhenAnyPassesOnExceptionOfFirstFinishedFuture) {
+    auto any{pool_party::whenAny(makeFutures(2))};
+
+    m_states[0]->setException(std::make_exception_ptr(std::logic_error{"failed"}));
+    m_states[1]->setValue("b");
+
+    EXPECT_THROW(any.get(), std::logic_error);
+}
+
+TEST_F(CombinatorsTests, WhenAnyRequiresFutures) {
+    EXPECT_THROW(pool_party::whenAny(std::vector<Future<int>>{}), std::invalid_argument);
+}
+
+TEST_F(CombinatorsTests, ContinuationOfCombinedFutureRunsAfterAllResults) {
+    std::string concatenated{};
+    auto all{pool_party::whenAll(makeFutures(2)).then([&concatenated](std::vector<std::string> values) {
+        concatenated = values[0] + values[1];
+    })};
+
+    m_states[1]->setValue("b");
+    EXPECT_TRUE(concatenated.empty());
+    m_states[0]->setValue("a");
+
+    EXPECT_THAT(concatenated, Eq("ab"));
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/cpu_topology.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+
+namespace {
+using pool_party::detail::CpuInfo;
+
+// Two packages with two cores each, every core has two hyper threads
+const std::vector<CpuInfo> dual_socket_topology{{0, 0, 0}, {1, 1, 0}, {2, 0, 1}, {3, 1, 1},
+                                                {4, 0, 0}, {5, 1, 0}, {6, 0, 1}, {7, 1, 1}};
+}  // namespace
+
+class CpuTopologyTests : public testing::Test {
+protected:
+    std::filesystem::path m_sysfs_path{std::filesystem::temp_directory_path() / "pool_party_cpu_topology_tests"};
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_sysfs_path);
+    }
+
+    void writeTopology(const CpuInfo& cpu_info) {
+        const auto topology_path{m_sysfs_path / ("cpu" + std::to_string(cpu_info.cpu)) / "topology"};
+        std::filesystem::create_directories(topology_path);
+        std::ofstream{topology_path / "core_id"} << cpu_info.core << '\n';
+        std::ofstream{topology_path / "physical_package_id"} << cpu_info.package << '\n';
+    }
+};
+
+TEST_F(CpuTopologyTests, AvailableCpusAreListed) {
+    EXPECT_FALSE(pool_party::detail::availableCpus().empty());
+}
+
+TEST_F(CpuTopologyTests, ReadCoreAndPackageFromSysfs) {
+    writeTopology(CpuInfo{3, 1, 1});
+
+    const auto topology{pool_party::detail::readCpuTopology({3}, m_sysfs_path.string())};
+    ASSERT_THAT(topology.size(), Eq(1U));
+    EXPECT_THAT(topology[0].cpu, Eq(3U));
+    EXPECT_THAT(topology[0].core, Eq(1U));
+    EXPECT_THAT(topology[0].package, Eq(1U));
+}
+
+TEST_F(CpuTopologyTests, CpusWithoutTopologyAreSeparateCores) {
+    const auto topology{pool_party::detail::readCpuTopology({5}, m_sysfs_path.string())};
+    ASSERT_THAT(topology.size(), Eq(1U));
+    EXPECT_THAT(topology[0].core, Eq(5U));
+    EXPECT_THAT(topology[0].package, Eq(0U));
+}
+
+TEST_F(CpuTopologyTests, CompactOrderFillsCoresAndPackagesFirst) {
+    EXPECT_THAT(pool_party::detail::compactCpuOrder(dual_socket_topology), ElementsAre(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+TEST_F(CpuTopologyTests, ScatterOrderSpreadsOverPackagesAndCoresFirst) {
+    EXPECT_THAT(pool_party::detail::scatterCpuOrder(dual_socket_topology), ElementsAre(0, 2, 1, 3, 4, 6, 5, 7));
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/fifo_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using testing::Eq;
+
+class FifoQueueTests : public testing::Test {
+protected:
+    pool_party::detail::FifoQueue<int> m_queue{2};
+};
+
+TEST_F(FifoQueueTests, PopFromEmptyQueueFails) {
+    int task{0};
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(task, 0));
+}
+
+TEST_F(FifoQueueTests, TaskOrderIsFifoForAllWorkers) {
+    m_queue.push(1, 0);
+    m_queue.push(2, pool_party::detail::no_worker_index);
+    m_queue.push(3, 1);
+
+    int task{0};
+    for (int expected_task{1}; expected_task <= 3; ++expected_task) {
+        ASSERT_TRUE(m_queue.tryPop(task, 1));
+        EXPECT_THAT(task, Eq(expected_task));
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(FifoQueueTests, PushRangeKeepsTaskOrder) {
+    std::vector<int> tasks{1, 2, 3};
+    EXPECT_THAT(m_queue.push(tasks.begin(), tasks.end(), pool_party::detail::no_worker_index), Eq(tasks.end()));
+    EXPECT_THAT(m_queue.size(), Eq(3U));
+
+    int task{0};
+    for (int expected_task{1}; expected_task <= 3; ++expected_task) {
+        ASSERT_TRUE(m_queue.tryPop(task, 0));
+        EXPECT_THAT(task, Eq(expected_task));
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(FifoQueueTests, PushToFullQueueFails) {
+    pool_party::detail::FifoQueue<int> queue{2, 1};
+
+    EXPECT_TRUE(queue.push(1, 0));
+    EXPECT_FALSE(queue.push(2, 0));
+
+    int task{0};
+    ASSERT_TRUE(queue.tryPop(task, 0));
+    EXPECT_THAT(task, Eq(1));
+    EXPECT_TRUE(queue.push(3, 0));
+}
+
+TEST_F(FifoQueueTests, PushRangeStopsAtCapacity) {
+    pool_party::detail::FifoQueue<int> queue{2, 3};
+    queue.push(1, 0);
+    std::vector<int> tasks{2, 3, 4};
+
+    EXPECT_THAT(queue.push(tasks.begin(), tasks.end(), 0), Eq(tasks.begin() + 2));
+    EXPECT_THAT(queue.size(), Eq(3U));
+    EXPECT_THAT(queue.push(tasks.begin() + 2, tasks.end(), 0), Eq(tasks.begin() + 2));
+}
+
+TEST_F(FifoQueueTests, QueueIsUnboundedWithoutCapacity) {
+    EXPECT_THAT(pool_party::detail::queueCapacity(m_queue), Eq(pool_party::detail::FifoQueue<int>::unbounded));
+
+    pool_party::detail::FifoQueue<int> bounded_queue{2, 3};
+    EXPECT_THAT(pool_party::detail::queueCapacity(bounded_queue), Eq(3U));
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/future.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using pool_party::detail::Future;
+using pool_party::detail::Task;
+using testing::Eq;
+
+namespace {
+
+/// Executor which stores scheduled continuations, so the test decides when they run
+struct ExecutorFake {
+    std::vector<Task> scheduled{};
+
+    static void schedule(void* executor, Task&& continuation) {
+        static_cast<ExecutorFake*>(executor)->scheduled.push_back(std::move(continuation));
+    }
+
+    void runScheduled() {
+        auto tasks{std::move(scheduled)};
+        for (auto& task : tasks) {
+            task();
+        }
+    }
+};
+
+}  // namespace
+
+class FutureTests : public testing::Test {
+protected:
+    ExecutorFake m_executor{};
+
+    template<typename R>
+    std::shared_ptr<typename Future<R>::StateType> makeState() {
+        return std::make_shared<typename Future<R>::StateType>(&ExecutorFake::schedule, &m_executor);
+    }
+};
+
+TEST_F(FutureTests, DefaultConstructedFutureIsInvalid) {
+    EXPECT_FALSE(Future<int>{}.valid());
+}
+
+TEST_F(FutureTests, GetReturnsPublishedValueAndInvalidatesFuture) {
+    auto state{makeState<std::string>()};
+    Future<std::string> future{state};
+    EXPECT_FALSE(future.isReady());
+
+    state->setValue("result");
+
+    EXPECT_TRUE(future.isReady());
+    EXPECT_THAT(future.get(), Eq("result"));
+    EXPECT_FALSE(future.valid());
+}
+
+TEST_F(FutureTests, GetRethrowsPublishedException) {
+    auto state{makeState<void>()};
+    Future<void> future{state};
+
+    state->setException(std::make_exception_ptr(std::logic_error{"failed"}));
+
+    EXPECT_THROW(future.get(), std::logic_error);
+}
+
+TEST_F(FutureTests, GetBlocksUntilValueIsPublished) {
+    auto state{makeState<int>()};
+    Future<int> future{state};
+
+    std::thread producer{[state]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        state->setValue(5);
+    }};
+
+    EXPECT_THAT(future.get(), Eq(5));
+    producer.join();
+}
+
+TEST_F(FutureTests, ContinuationIsScheduledWhenValueIsPublished) {
+    auto state{makeState<int>()};
+    auto continued{Future<int>{state}.then([](int value) { return value + 1; })};
+
+    EXPECT_TRUE(m_executor.scheduled.empty());
+    state->setValue(1);
+    ASSERT_THAT(m_executor.scheduled.size(), Eq(1U));
+    EXPECT_FALSE(continued.isReady());
+
+    m_executor.runScheduled();
+    EXPECT_THAT(continued.get(), Eq(2));
+}
+
+TEST_F(FutureTests, ContinuationOfReadyFutureIsScheduledImmediately) {
+    auto state{makeState<int>()};
+    state->setValue(1);
+
+    auto continued{Future<int>{state}.then([](int value) { return std::to_string(value); })};
+
+    ASSERT_THAT(m_executor.scheduled.size(), Eq(1U));
+    m_executor.runScheduled();
+    EXPECT_THAT(continued.get(), Eq("1"));
+}
+
+TEST_F(FutureTests, ContinuationReceivesMoveOnlyValue) {
+    auto state{makeState<std::unique_ptr<int>>()};
+    auto continued{Future<std::unique_ptr<int>>{state}.then([](std::unique_ptr<int> value) { return *value; })};
+
+    state->setValue(new int{7});
+    m_executor.runScheduled();
+
+    EXPECT_THAT(continued.get(), Eq(7));
+}
+
+TEST_F(FutureTests, ExceptionSkipsContinuation) {
+    auto state{makeState<void>()};
+    bool called{false};
+    auto continued{Future<void>{state}.then([&called]() { called = true; })};
+
+    state->setException(std::make_exception_ptr(std::logic_error{"failed"}));
+    m_executor.runScheduled();
+
+    EXPECT_FALSE(called);
+    EXPECT_THROW(continued.get(), std::logic_error);
+}
+
+TEST_F(FutureTests, ExceptionOfContinuationIsPassedOn) {
+    auto state{makeState<int>()};
+    auto continued{Future<int>{state}.then([](int) -> int { throw std::logic_error{"failed"}; })};
+
+    state->setValue(1);
+    m_executor.runScheduled();
+
+    EXPECT_THROW(continued.get(), std::logic_error);
+}
+
+TEST_F(FutureTests, DroppedContinuationReportsBrokenPromise) {
+    auto state{makeState<int>()};
+    auto continued{Future<int>{state}.then([](int value) { return value + 1; })};
+
+    state->setValue(1);
+    ASSERT_THAT(m_executor.scheduled.size(), Eq(1U));
+    EXPECT_FALSE(continued.isReady());
+
+    m_executor.scheduled.clear();
+    ASSERT_TRUE(continued.isReady());
+    EXPECT_THROW(continued.get(), std::future_error);
+}
+
+TEST_F(FutureTests, ContinuationRunsInlineWithoutScheduler) {
+    auto state{std::make_shared<Future<int>::StateType>(nullptr, nullptr)};
+    auto continued{Future<int>{state}.then([](int value) { return value * 3; })};
+
+    state->setValue(2);
+
+    EXPECT_TRUE(continued.isReady());
+    EXPECT_THAT(continued.get(), Eq(6));
+}
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/hill_climbing.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+
+using pool_party::detail::ConcurrencyReason;
+using testing::DoubleEq;
+using testing::Eq;
+
+class HillClimbingTests : public testing::Test {
+protected:
+    pool_party::detail::HillClimbing m_controller{2, 4, 2};
+
+    pool_party::detail::ConcurrencyDecision sample(std::size_t completed_tasks) {
+        return m_controller.update(completed_tasks, std::chrono::seconds{1});
+    }
+};
+
+TEST_F(HillClimbingTests, InitialTargetIsClampedToBounds) {
+    EXPECT_THAT(pool_party::detail::HillClimbing(2, 4, 8).getTarget(), Eq(4U));
+    EXPECT_THAT(pool_party::detail::HillClimbing(2, 4, 0).getTarget(), Eq(2U));
+}
+
+TEST_F(HillClimbingTests, BaselineMeasurementProbesNextTarget) {
+    const auto decision{sample(100)};
+
+    EXPECT_THAT(decision.reason, Eq(ConcurrencyReason::baseline_measured));
+    EXPECT_THAT(decision.previous_target, Eq(2U));
+    EXPECT_THAT(decision.target, Eq(3U));
+    EXPECT_THAT(decision.throughput, DoubleEq(100.0));
+    EXPECT_THAT(m_controller.getTarget(), Eq(3U));
+}
+
+TEST_F(HillClimbingTests, ThroughputIsMeasuredPerSecond) {
+    const auto decision{m_controller.update(100, std::chrono::milliseconds{500})};
+
+    EXPECT_THAT(decision.throughput, DoubleEq(200.0));
+}
+
+TEST_F(HillClimbingTests, ImprovedProbeIsKeptAndClimbingContinues) {
+    sample(100);
+    const auto decision{sample(150)};
+
+    EXPECT_THAT(decision.reason, Eq(ConcurrencyReason::throughput_improved));
+    EXPECT_THAT(decision.previous_target, Eq(3U));
+    EXPECT_THAT(decision.target, Eq(4U));
+    EXPECT_THAT(decision.baseline_throughput, DoubleEq(100.0));
+}
+
+TEST_F(HillClimbingTests, DeclinedProbeRestoresPreviousTarget) {
+    sample(100);
+    const auto decision{sample(90)};
+
+    EXPECT_THAT(decision.reason, Eq(ConcurrencyReason::throughput_declined));
+    EXPECT_THAT(decision.previous_target, Eq(3U));
+    EXPECT_THAT(decision.target, Eq(2U));
+    EXPECT_THAT(decision.baseline_throughput, DoubleEq(100.0));
+}
+
+TEST_F(HillClimbingTests, GainBelowMinimumImprovementDoesntKeepProbe) {
+    sample(100);
+
+    EXPECT_THAT(sample(104).reason, Eq(ConcurrencyReason::throughput_declined));
+}
+
+TEST_F(HillClimbingTests, TurnsAroundAtUpperBound) {
+    sample(100);
+    sample(150);
+    const auto improved{sample(200)};
+    EXPECT_THAT(improved.reason, Eq(ConcurrencyReason::throughput_improved));
+    EXPECT_THAT(improved.target, Eq(4U));
+
+    const auto measured{sample(200)};
+    EXPECT_THAT(measured.reason, Eq(ConcurrencyReason::baseline_measured));
+    EXPECT_THAT(measured.previous_target, Eq(4U));
+    EXPECT_THAT(measured.target, Eq(3U));
+}
+
+TEST_F(HillClimbingTests, ProbesOppositeDirectionAfterDeclinedProbe) {
+    pool_party::detail::HillClimbing controller{1, 4, 2};
+    controller.update(100, std::chrono::seconds{1});
+    controller.update(80, std::chrono::seconds{1});
+
+    const auto decision{controller.update(100, std::chrono::seconds{1})};
+
+    EXPECT_THAT(decision.reason, Eq(ConcurrencyReason::baseline_measured));
+    EXPECT_THAT(decision.target, Eq(1U));
+}
+
+TEST_F(HillClimbingTests, FollowsDriftingOptimum) {
+    pool_party::detail::HillClimbing controller{1, 8, 4};
+    // Throughput peaks at 4 workers first, then at 6 workers
+    auto throughput_at = [](std::size_t target, std::size_t optimum) {
+        const auto distance{target > optimum ? target - optimum : optimum - target};
+        return 1000 - distance * 100;
+    };
+
+    for (int step{0}; step < 20; ++step) {
+        controller.update(throughput_at(controller.getTarget(), 4), std::chrono::seconds{1});
+        EXPECT_THAT(controller.getTarget(), testing::AllOf(testing::Ge(3U), testing::Le(5U)));
+    }
+    for (int step{0}; step < 20; ++step) {
+        controller.update(throughput_at(controller.getTarget(), 6), std::chrono::seconds{1});
+    }
+    EXPECT_THAT(controller.getTarget(), testing::AllOf(testing::Ge(5U), testing::Le(7U)));
+}
+
+TEST_F(HillClimbingTests, FixedBoundsKeepTarget) {
+    pool_party::detail::HillClimbing controller{3, 3, 3};
+
+    const auto decision{controller.update(100, std::chrono::seconds{1})};
+
+    EXPECT_THAT(decision.reason, Eq(ConcurrencyReason::baseline_measured));
+    EXPECT_THAT(decision.target, Eq(3U));
+    EXPECT_THAT(controller.update(50, std::chrono::seconds{1}).target, Eq(3U));
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/in_flight_counter.hpp"
+#include "pool_party/detail/queue_tags.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using pool_party::detail::no_worker_index;
+
+class InFlightCounterTests : public testing::Test {
+protected:
+    pool_party::detail::InFlightCounter m_counter{2};
+};
+
+TEST_F(InFlightCounterTests, CounterIsZeroInitially) {
+    EXPECT_TRUE(m_counter.isZero());
+}
+
+TEST_F(InFlightCounterTests, OperationsFinishOnOtherStripes) {
+    m_counter.start(no_worker_index, 3);
+    EXPECT_FALSE(m_counter.isZero());
+
+    m_counter.finish(0, 1);
+    m_counter.finish(1, 1);
+    EXPECT_FALSE(m_counter.isZero());
+
+    std::thread other_thread{[this]() { m_counter.finish(no_worker_index, 1); }};
+    other_thread.join();
+    EXPECT_TRUE(m_counter.isZero());
+}
+
+TEST_F(InFlightCounterTests, FinishReportsRegisteredWaiters) {
+    m_counter.start(0, 2);
+    EXPECT_FALSE(m_counter.finish(0, 1));
+
+    m_counter.addWaiter();
+    EXPECT_TRUE(m_counter.finish(1, 1));
+    m_counter.removeWaiter();
+    EXPECT_TRUE(m_counter.isZero());
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/lifo_slot_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using pool_party::detail::no_worker_index;
+using testing::Eq;
+
+class LifoSlotQueueTests : public testing::Test {
+protected:
+    using QueueType = pool_party::detail::LifoSlotQueue<int>;
+
+    QueueType m_queue{2};
+    int m_task{0};
+
+    void waitForStealDelay() {
+        std::this_thread::sleep_for(QueueType::steal_delay * 2);
+    }
+};
+
+TEST_F(LifoSlotQueueTests, PopFromEmptyQueueFails) {
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 0));
+    EXPECT_FALSE(m_queue.tryPop(m_task, no_worker_index));
+}
+
+TEST_F(LifoSlotQueueTests, WorkerTakesTaskFromItsSlotFirst) {
+    m_queue.push(1, no_worker_index);
+    m_queue.push(2, 0);
+    EXPECT_THAT(m_queue.size(), Eq(2U));
+
+    for (const int expected_task : {2, 1}) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        EXPECT_THAT(m_task, Eq(expected_task));
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(LifoSlotQueueTests, OlderSlotTaskGivesWayToSharedQueue) {
+    m_queue.push(1, 0);
+    m_queue.push(2, 0);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+    EXPECT_THAT(m_task, Eq(1));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(2));
+}
+
+TEST_F(LifoSlotQueueTests, TasksFromOutsideThePoolAreFifo) {
+    m_queue.push(1, no_worker_index);
+    std::vector<int> tasks{2, 3};
+    EXPECT_THAT(m_queue.push(tasks.begin(), tasks.end(), 0), Eq(tasks.end()));
+
+    for (const int expected_task : {1, 2, 3}) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+        EXPECT_THAT(m_task, Eq(expected_task));
+    }
+}
+
+TEST_F(LifoSlotQueueTests, SlotIsStolenOnlyAfterStealDelay) {
+    m_queue.push(1, 0);
+
+    EXPECT_FALSE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 1));
+
+    waitForStealDelay();
+    ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+    EXPECT_THAT(m_task, Eq(1));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(LifoSlotQueueTests, OtherWorkersWaitForTheRestOfTheStealDelay) {
+    EXPECT_THAT(m_queue.reservedFor(1), Eq(std::chrono::steady_clock::duration::zero()));
+
+    m_queue.push(1, 0);
+    EXPECT_THAT(m_queue.reservedFor(0), Eq(std::chrono::steady_clock::duration::zero()));
+    EXPECT_THAT(m_queue.reservedFor(1), testing::Gt(std::chrono::steady_clock::duration::zero()));
+    EXPECT_THAT(m_queue.reservedFor(1), testing::Le(QueueType::steal_delay));
+
+    waitForStealDelay();
+    EXPECT_THAT(m_queue.reservedFor(1), Eq(std::chrono::steady_clock::duration::zero()));
+}
+
+TEST_F(LifoSlotQueueTests, SharedTaskEndsTheWaitForSlots) {
+    m_queue.push(1, 0);
+    m_queue.push(2, no_worker_index);
+    EXPECT_THAT(m_queue.reservedFor(1), Eq(std::chrono::steady_clock::duration::zero()));
+}
+
+TEST_F(LifoSlotQueueTests, ThreadsOutsideThePoolStealFromSlots) {
+    m_queue.push(1, 1);
+    waitForStealDelay();
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, no_worker_index));
+    EXPECT_THAT(m_task, Eq(1));
+}
+
+TEST_F(LifoSlotQueueTests, LongSlotStreakLetsSharedTaskPass) {
+    m_queue.push(0, no_worker_index);
+    for (std::size_t task{1}; task <= QueueType::max_slot_streak; ++task) {
+        m_queue.push(static_cast<int>(task), 0);
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        EXPECT_THAT(m_task, Eq(static_cast<int>(task)));
+    }
+
+    m_queue.push(-1, 0);
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(0));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(-1));
+}
+
+TEST_F(LifoSlotQueueTests, PushFailsWhenCapacityIsReached) {
+    QueueType queue{2, 2};
+    queue.push(1, 0);
+    std::vector<int> tasks{2, 3};
+
+    EXPECT_THAT(queue.push(tasks.begin(), tasks.end(), no_worker_index), Eq(tasks.begin() + 1));
+    EXPECT_FALSE(queue.push(4, 1));
+    EXPECT_THAT(queue.size(), Eq(2U));
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/mpmc_ring_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using testing::Eq;
+
+class MpmcRingQueueTests : public testing::Test {
+protected:
+    pool_party::detail::MpmcRingQueue<int> m_queue{1, 3};
+    int m_task{0};
+};
+
+TEST_F(MpmcRingQueueTests, CapacityIsRoundedUpToPowerOfTwo) {
+    EXPECT_THAT(m_queue.capacity(), Eq(4U));
+}
+
+TEST_F(MpmcRingQueueTests, CapacityIsAtLeastTwo) {
+    pool_party::detail::MpmcRingQueue<int> queue{1, 1};
+    EXPECT_THAT(queue.capacity(), Eq(2U));
+}
+
+TEST_F(MpmcRingQueueTests, PopFromEmptyQueueFails) {
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 0));
+}
+
+TEST_F(MpmcRingQueueTests, TaskOrderIsFifo) {
+    for (int task{0}; task < 4; ++task) {
+        ASSERT_TRUE(m_queue.push(int{task}, 0));
+    }
+
+    for (int expected_task{0}; expected_task < 4; ++expected_task) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        EXPECT_THAT(m_task, Eq(expected_task));
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(MpmcRingQueueTests, PushToFullQueueFailsWithoutTouchingTask) {
+    pool_party::detail::MpmcRingQueue<std::unique_ptr<int>> queue{1, 2};
+    ASSERT_TRUE(queue.push(std::unique_ptr<int>{new int{0}}, 0));
+    ASSERT_TRUE(queue.push(std::unique_ptr<int>{new int{1}}, 0));
+
+    std::unique_ptr<int> task{new int{2}};
+    EXPECT_FALSE(queue.push(std::move(task), 0));
+    ASSERT_TRUE(task);
+    EXPECT_THAT(*task, Eq(2));
+}
+
+TEST_F(MpmcRingQueueTests, PushRangeStopsAtFirstTaskWhichDoesNotFit) {
+    std::vector<int> tasks{0, 1, 2, 3, 4, 5};
+    ASSERT_TRUE(m_queue.push(int{-1}, 0));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+
+    EXPECT_THAT(m_queue.push(tasks.begin(), tasks.end(), 0), Eq(tasks.begin() + 4));
+
+    for (int expected_task{0}; expected_task < 4; ++expected_task) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        EXPECT_THAT(m_task, Eq(expected_task));
+    }
+    EXPECT_THAT(m_queue.push(tasks.begin() + 4, tasks.end(), 0), Eq(tasks.end()));
+}
+
+TEST_F(MpmcRingQueueTests, ReleaseRemainingTasksOnDestruction) {
+    auto shared_value{std::make_shared<int>(0)};
+    {
+        pool_party::detail::MpmcRingQueue<std::shared_ptr<int>> queue{1, 2};
+        queue.push(std::shared_ptr<int>{shared_value}, 0);
+        EXPECT_THAT(shared_value.use_count(), Eq(2));
+    }
+    EXPECT_THAT(shared_value.use_count(), Eq(1));
+}
+
+TEST_F(MpmcRingQueueTests, EachTaskIsTakenExactlyOnceByConcurrentConsumers) {
+    const int task_count{100000};
+    const int thread_count{2};
+    pool_party::detail::MpmcRingQueue<int> queue{thread_count, 64};
+    std::vector<std::atomic_int> taken(task_count);
+    std::atomic_int taken_count{0};
+
+    std::vector<std::thread> threads{};
+    for (int producer{0}; producer < thread_count; ++producer) {
+        threads.emplace_back([&queue, producer]() {
+            for (int task{producer}; task < task_count; task += thread_count) {
+                while (!queue.push(int{task}, 0)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int consumer{0}; consumer < thread_count; ++consumer) {
+        threads.emplace_back([&queue, &taken, &taken_count]() {
+            int task{0};
+            while (taken_count < task_count) {
+                if (queue.tryPop(task, 0)) {
+                    ++taken[static_cast<std::size_t>(task)];
+                    ++taken_count;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& count : taken) {
+        EXPECT_THAT(count.load(), Eq(1));
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/mpsc_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using testing::Eq;
+
+class MpscQueueTests : public testing::Test {
+protected:
+    pool_party::detail::MpscQueue<int> m_queue{};
+};
+
+TEST_F(MpscQueueTests, PopFromEmptyQueueFails) {
+    int item{0};
+    EXPECT_FALSE(m_queue.tryPop(item));
+}
+
+TEST_F(MpscQueueTests, PopsInFifoOrder) {
+    m_queue.push(1);
+    m_queue.push(2);
+
+    int item{0};
+    ASSERT_TRUE(m_queue.tryPop(item));
+    EXPECT_THAT(item, Eq(1));
+    ASSERT_TRUE(m_queue.tryPop(item));
+    EXPECT_THAT(item, Eq(2));
+    EXPECT_FALSE(m_queue.tryPop(item));
+}
+
+TEST_F(MpscQueueTests, ItemsOfEachProducerArriveInPushOrder) {
+    const int item_count{20000};
+    const int producer_count{3};
+
+    std::vector<std::thread> producers{};
+    for (int producer{0}; producer < producer_count; ++producer) {
+        producers.emplace_back([this, producer]() {
+            for (int i{0}; i < item_count; ++i) {
+                m_queue.push(producer * item_count + i);
+            }
+        });
+    }
+
+    std::vector<int> next_items(producer_count, 0);
+    int item{0};
+    for (int popped{0}; popped < producer_count * item_count;) {
+        if (!m_queue.tryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto& next_item{next_items[static_cast<std::size_t>(item / item_count)]};
+        EXPECT_THAT(item % item_count, Eq(next_item));
+        next_item = item % item_count + 1;
+        ++popped;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_THAT(next_items, testing::Each(Eq(item_count)));
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/numa_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using testing::Eq;
+
+namespace {
+// Node 2 is closer to node 0 than node 1
+const std::vector<pool_party::detail::NumaNode> three_nodes{{0, {0}, {10, 30, 20}},
+                                                            {1, {1}, {30, 10, 20}},
+                                                            {2, {2}, {20, 20, 10}}};
+}  // namespace
+
+class NumaQueueTests : public testing::Test {
+protected:
+    pool_party::detail::NumaQueue<int> m_queue{6, three_nodes};
+    int m_task{0};
+};
+
+TEST_F(NumaQueueTests, PopFromEmptyQueueFails) {
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 0));
+}
+
+TEST_F(NumaQueueTests, WorkersAreDistributedRoundRobinOverNodes) {
+    EXPECT_THAT(m_queue.getNodeOfWorker(0), Eq(0U));
+    EXPECT_THAT(m_queue.getNodeOfWorker(1), Eq(1U));
+    EXPECT_THAT(m_queue.getNodeOfWorker(2), Eq(2U));
+    EXPECT_THAT(m_queue.getNodeOfWorker(3), Eq(0U));
+}
+
+TEST_F(NumaQueueTests, WorkerPrefersTasksOfItsNode) {
+    m_queue.push(1, 0);
+    m_queue.push(2, 1);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 4));
+    EXPECT_THAT(m_task, Eq(2));
+}
+
+TEST_F(NumaQueueTests, WorkerTakesTasksOfNearestNodeFirst) {
+    std::vector<int> tasks{1, 2};
+    m_queue.pushToNode(tasks.begin(), tasks.begin() + 1, 1);
+    m_queue.pushToNode(tasks.begin() + 1, tasks.end(), 2);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(2));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(1));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(NumaQueueTests, PushToUnknownNodeFails) {
+    std::vector<int> tasks{1};
+    EXPECT_THROW(m_queue.pushToNode(tasks.begin(), tasks.end(), 3), std::out_of_range);
+    EXPECT_TRUE(m_queue.empty());
+}
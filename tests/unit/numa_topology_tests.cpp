@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/numa_topology.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+
+class NumaTopologyTests : public testing::Test {
+protected:
+    std::filesystem::path m_sysfs_path{std::filesystem::temp_directory_path() / "pool_party_numa_topology_tests"};
+
+    void SetUp() override {
+        std::filesystem::create_directories(m_sysfs_path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_sysfs_path);
+    }
+
+    void writeFile(const std::filesystem::path& relative_path, const std::string& content) {
+        std::filesystem::create_directories((m_sysfs_path / relative_path).parent_path());
+        std::ofstream{m_sysfs_path / relative_path} << content << '\n';
+    }
+};
+
+TEST_F(NumaTopologyTests, ParseSysfsList) {
+    EXPECT_THAT(pool_party::detail::parseSysfsList("8,0-2,10-11"), ElementsAre(0, 1, 2, 8, 10, 11));
+    EXPECT_TRUE(pool_party::detail::parseSysfsList("").empty());
+}
+
+TEST_F(NumaTopologyTests, ReadNodesWithTheirCpusAndDistances) {
+    writeFile("online", "0-1");
+    writeFile("node0/cpulist", "0-1");
+    writeFile("node0/distance", "10 21");
+    writeFile("node1/cpulist", "2-3");
+    writeFile("node1/distance", "21 10");
+
+    const auto nodes{pool_party::detail::readNumaTopology({0, 1, 2, 3}, m_sysfs_path.string())};
+    ASSERT_THAT(nodes.size(), Eq(2U));
+    EXPECT_THAT(nodes[0].id, Eq(0U));
+    EXPECT_THAT(nodes[0].cpus, ElementsAre(0, 1));
+    EXPECT_THAT(nodes[0].distances, ElementsAre(10, 21));
+    EXPECT_THAT(nodes[1].id, Eq(1U));
+    EXPECT_THAT(nodes[1].cpus, ElementsAre(2, 3));
+}
+
+TEST_F(NumaTopologyTests, SkipNodesWithoutUsableCpus) {
+    writeFile("online", "0-1");
+    writeFile("node0/cpulist", "0-1");
+    writeFile("node1/cpulist", "2-3");
+
+    const auto nodes{pool_party::detail::readNumaTopology({1}, m_sysfs_path.string())};
+    ASSERT_THAT(nodes.size(), Eq(1U));
+    EXPECT_THAT(nodes[0].cpus, ElementsAre(1));
+}
+
+TEST_F(NumaTopologyTests, TreatMachineWithoutNumaInformationAsSingleNode) {
+    const auto nodes{pool_party::detail::readNumaTopology({0, 1}, m_sysfs_path.string())};
+    ASSERT_THAT(nodes.size(), Eq(1U));
+    EXPECT_THAT(nodes[0].id, Eq(0U));
+    EXPECT_THAT(nodes[0].cpus, ElementsAre(0, 1));
+}
+
+TEST_F(NumaTopologyTests, WorkerCpusAlternateBetweenNodes) {
+    const std::vector<pool_party::detail::NumaNode> nodes{{0, {0, 1}, {}}, {1, {4}, {}}};
+    EXPECT_THAT(pool_party::detail::numaWorkerCpus(nodes), ElementsAre(0, 4, 1, 4));
+}
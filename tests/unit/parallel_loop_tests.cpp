@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/parallel_loop.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using pool_party::Chunking;
+using testing::Each;
+using testing::ElementsAre;
+using testing::Eq;
+using testing::Ge;
+
+namespace {
+
+/// Pool which stores posted tasks, so the test decides when helpers run
+class FakePool {
+public:
+    explicit FakePool(std::size_t number_of_threads) : m_number_of_threads{number_of_threads} {}
+
+    std::size_t getNumberOfThreads() const {
+        return m_number_of_threads;
+    }
+
+    void post(std::function<void()> task) {
+        if (m_is_shutdown) {
+            throw std::runtime_error{"Thread pool already shut down, enqueuing failed."};
+        }
+        m_tasks.push_back(std::move(task));
+    }
+
+    std::size_t m_number_of_threads;
+    bool m_is_shutdown{false};
+    std::vector<std::function<void()>> m_tasks{};
+};
+
+}  // namespace
+
+class ParallelLoopTests : public testing::Test {
+protected:
+    FakePool m_pool{3};
+    std::vector<std::pair<std::size_t, std::size_t>> m_chunks{};
+
+    void run(std::size_t size, Chunking chunking, std::size_t grain_size) {
+        pool_party::detail::runParallelLoop(
+        m_pool, size, chunking, grain_size, [this](std::size_t begin, std::size_t end) {
+            m_chunks.emplace_back(begin, end);
+        });
+    }
+
+    std::vector<std::size_t> chunkSizes() const {
+        std::vector<std::size_t> sizes{};
+        for (const auto& chunk : m_chunks) {
+            sizes.push_back(chunk.second - chunk.first);
+        }
+        return sizes;
+    }
+};
+
+TEST_F(ParallelLoopTests, StaticChunkingSplitsEvenlyBetweenParticipants) {
+    run(10, Chunking::static_size, 1);
+
+    EXPECT_THAT(chunkSizes(), ElementsAre(3, 3, 3, 1));
+    EXPECT_THAT(m_pool.m_tasks.size(), Eq(3U));
+}
+
+TEST_F(ParallelLoopTests, GuidedChunksShrinkDownToGrainSize) {
+    run(100, Chunking::guided, 4);
+
+    EXPECT_THAT(chunkSizes(), ElementsAre(12, 11, 9, 8, 7, 6, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1));
+}
+
+TEST_F(ParallelLoopTests, AdaptiveChunksCoverRangeWithoutGaps) {
+    run(1000, Chunking::adaptive, 2);
+
+    std::size_t expected_begin{0};
+    for (const auto& chunk : m_chunks) {
+        EXPECT_THAT(chunk.first, Eq(expected_begin));
+        expected_begin = chunk.second;
+    }
+    EXPECT_THAT(expected_begin, Eq(1000U));
+    EXPECT_THAT(chunkSizes(), Each(Ge(1U)));
+}
+
+TEST_F(ParallelLoopTests, NoHelpersForSingleChunk) {
+    run(8, Chunking::guided, 8);
+
+    EXPECT_THAT(chunkSizes(), ElementsAre(8));
+    EXPECT_TRUE(m_pool.m_tasks.empty());
+}
+
+TEST_F(ParallelLoopTests, LateHelpersFindNoWork) {
+    run(10, Chunking::static_size, 1);
+    const auto number_of_chunks{m_chunks.size()};
+
+    for (auto& task : m_pool.m_tasks) {
+        task();
+    }
+
+    EXPECT_THAT(m_chunks.size(), Eq(number_of_chunks));
+}
+
+TEST_F(ParallelLoopTests, EmptyLoopPostsNoHelpers) {
+    run(0, Chunking::guided, 1);
+
+    EXPECT_TRUE(m_chunks.empty());
+    EXPECT_TRUE(m_pool.m_tasks.empty());
+}
+
+TEST_F(ParallelLoopTests, ExceptionSkipsRemainingChunksAndIsRethrown) {
+    std::size_t calls{0};
+
+    const auto failing_chunk = [&calls](std::size_t, std::size_t) {
+        ++calls;
+        throw std::logic_error{"failed"};
+    };
+
+    EXPECT_THROW(pool_party::detail::runParallelLoop(m_pool, 10, Chunking::static_size, 1, failing_chunk),
+                 std::logic_error);
+    EXPECT_THAT(calls, Eq(1U));
+}
+
+TEST_F(ParallelLoopTests, CallerFinishesLoopWhenPoolIsShutDown) {
+    m_pool.m_is_shutdown = true;
+
+    EXPECT_THROW(run(10, Chunking::static_size, 1), std::runtime_error);
+    EXPECT_THAT(chunkSizes(), ElementsAre(3, 3, 3, 1));
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/pinned_thread_factory.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+
+namespace {
+class ThreadFake {
+public:
+    template<typename Callable, typename... Args>
+    explicit ThreadFake(Callable&& callable, Args&&... args) {
+        callable(std::forward<Args>(args)...);
+    }
+};
+
+struct AffinityFake {
+    static std::vector<std::size_t> pinned_cpus;
+
+    static bool pinCurrentThread(std::size_t cpu) {
+        pinned_cpus.push_back(cpu);
+        return true;
+    }
+};
+std::vector<std::size_t> AffinityFake::pinned_cpus{};
+
+using PinnedThreadFactoryType = pool_party::detail::PinnedThreadFactory<ThreadFake, AffinityFake>;
+}  // namespace
+
+class PinnedThreadFactoryTests : public testing::Test {
+protected:
+    void SetUp() override {
+        AffinityFake::pinned_cpus.clear();
+    }
+};
+
+TEST_F(PinnedThreadFactoryTests, PinThreadBeforeCallingThreadFunction) {
+    PinnedThreadFactoryType thread_factory{std::vector<std::size_t>{3}};
+
+    std::size_t pinned_cpus_when_called{0};
+    auto created_thread{thread_factory.create(
+    [&pinned_cpus_when_called](int) { pinned_cpus_when_called = AffinityFake::pinned_cpus.size(); }, 42)};
+    EXPECT_THAT(pinned_cpus_when_called, Eq(1U));
+    EXPECT_THAT(AffinityFake::pinned_cpus, ElementsAre(3));
+}
+
+TEST_F(PinnedThreadFactoryTests, AssignCpuListRoundRobin) {
+    PinnedThreadFactoryType thread_factory{std::vector<std::size_t>{2, 5}};
+
+    for (int i{0}; i < 3; ++i) {
+        thread_factory.create([]() {});
+    }
+    EXPECT_THAT(AffinityFake::pinned_cpus, ElementsAre(2, 5, 2));
+}
+
+TEST_F(PinnedThreadFactoryTests, PinWorkerToCpuOfItsIndex) {
+    PinnedThreadFactoryType thread_factory{std::vector<std::size_t>{2, 5, 7}};
+
+    thread_factory.create([]() {});
+    thread_factory.createWorker(1, []() {});
+    thread_factory.createWorker(1, []() {});
+    thread_factory.createWorker(3, []() {});
+    EXPECT_THAT(AffinityFake::pinned_cpus, ElementsAre(2, 5, 5, 2));
+}
+
+TEST_F(PinnedThreadFactoryTests, EmptyCpuListDisablesPinning) {
+    PinnedThreadFactoryType thread_factory{std::vector<std::size_t>{}};
+
+    bool thread_function_called{false};
+    thread_factory.create([&thread_function_called]() { thread_function_called = true; });
+    EXPECT_TRUE(thread_function_called);
+    EXPECT_TRUE(AffinityFake::pinned_cpus.empty());
+}
+
+TEST_F(PinnedThreadFactoryTests, OrderCpusByPlacement) {
+    const std::vector<pool_party::detail::CpuInfo> topology{{0, 0, 0}, {1, 1, 0}, {2, 0, 1}, {3, 1, 1}};
+
+    PinnedThreadFactoryType compact_factory{pool_party::detail::CpuPlacement::compact, topology};
+    PinnedThreadFactoryType scatter_factory{pool_party::detail::CpuPlacement::scatter, topology};
+    EXPECT_THAT(compact_factory.getCpus(), ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(scatter_factory.getCpus(), ElementsAre(0, 2, 1, 3));
+}
+
+#if defined(__linux__)
+TEST_F(PinnedThreadFactoryTests, PinCurrentThreadToAvailableCpu) {
+    const auto cpus{pool_party::detail::availableCpus()};
+    ASSERT_FALSE(cpus.empty());
+
+    std::thread pinned_thread{
+    [&cpus]() { EXPECT_TRUE(pool_party::detail::ThreadAffinity::pinCurrentThread(cpus.back())); }};
+    pinned_thread.join();
+}
+#endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/priority_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using pool_party::detail::Priority;
+using testing::Eq;
+
+class PriorityQueueTests : public testing::Test {
+protected:
+    pool_party::detail::PriorityQueue<int> m_queue{2, 4};
+    int m_task{0};
+
+    void pushTask(int task, Priority priority) {
+        m_queue.push(&task, &task + 1, 0, priority);
+    }
+};
+
+TEST_F(PriorityQueueTests, PopFromEmptyQueueFails) {
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 0));
+}
+
+TEST_F(PriorityQueueTests, TasksWithoutPriorityHaveNormalPriority) {
+    m_queue.push(1, 0);
+    pushTask(2, Priority::low);
+    pushTask(3, Priority::high);
+
+    for (const int expected_task : {3, 1, 2}) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        EXPECT_THAT(m_task, Eq(expected_task));
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(PriorityQueueTests, TaskOrderIsFifoWithinPriority) {
+    pushTask(1, Priority::critical);
+    pushTask(2, Priority::critical);
+    EXPECT_THAT(m_queue.size(), Eq(2U));
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(1));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(m_task, Eq(2));
+}
+
+TEST_F(PriorityQueueTests, StarvingTaskIsTakenNext) {
+    pushTask(0, Priority::low);
+    for (int task{1}; task <= 10; ++task) {
+        pushTask(task, Priority::high);
+    }
+
+    // Four high priority tasks may overtake the low priority task
+    std::vector<int> taken_tasks{};
+    for (int i{0}; i < 6; ++i) {
+        ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+        taken_tasks.push_back(m_task);
+    }
+    EXPECT_THAT(taken_tasks, testing::ElementsAre(1, 2, 3, 4, 5, 0));
+}
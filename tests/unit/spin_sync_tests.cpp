@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/spin_sync.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using testing::_;
+
+namespace {
+class MutexMock {
+public:
+    MOCK_METHOD(void, lock, ());
+    MOCK_METHOD(void, unlock, ());
+};
+using NiceMutexMock = testing::NiceMock<MutexMock>;
+
+class ConditionVariableMock {
+public:
+    MOCK_METHOD(void, wait, (std::unique_lock<NiceMutexMock>&, std::function<bool()>) );
+    MOCK_METHOD(bool,
+                wait_until,
+                (std::unique_lock<NiceMutexMock>&, std::chrono::steady_clock::time_point, std::function<bool()>) );
+    MOCK_METHOD(void, notify_one, ());
+    MOCK_METHOD(void, notify_all, ());
+};
+using NiceConditionVariableMock = testing::NiceMock<ConditionVariableMock>;
+using SpinSyncType              = pool_party::detail::SpinSync<NiceMutexMock, NiceConditionVariableMock>;
+}  // namespace
+
+class SpinSyncTests : public testing::Test {
+protected:
+    SpinSyncType m_sync{};
+    NiceMutexMock& mutex_mock{m_sync.getMutex()};
+    NiceConditionVariableMock& condition_variable_mock{m_sync.getConditionVariable()};
+};
+
+TEST_F(SpinSyncTests, ExecuteCallableWithoutWaitingWhenPredicateHolds) {
+    EXPECT_CALL(condition_variable_mock, wait(_, _)).Times(0);
+
+    bool locked_while_called{false};
+    m_sync.waitThenExecute([]() { return true; }, [&locked_while_called](std::unique_lock<NiceMutexMock>& ul) {
+        locked_while_called = ul.owns_lock();
+    });
+    EXPECT_TRUE(locked_while_called);
+}
+
+TEST_F(SpinSyncTests, ParkWhenSpinBudgetIsExhausted) {
+    SpinSyncType sync{0};
+    EXPECT_CALL(sync.getConditionVariable(), wait(_, _));
+
+    sync.waitThenExecute([]() { return false; }, [](std::unique_lock<NiceMutexMock>&) {});
+}
+
+TEST_F(SpinSyncTests, PickUpNotificationWhileSpinning) {
+    std::atomic_bool work_available{false};
+    m_sync.setSpinBudget(std::numeric_limits<std::size_t>::max());
+    EXPECT_CALL(condition_variable_mock, wait(_, _)).Times(0);
+
+    std::thread producer{[this, &work_available]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        work_available = true;
+        m_sync.notifyOne();
+    }};
+
+    bool callback_called{false};
+    m_sync.waitThenExecute([&work_available]() { return work_available.load(); },
+                           [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; });
+    producer.join();
+    EXPECT_TRUE(callback_called);
+}
+
+TEST_F(SpinSyncTests, TimedWaitParksUntilDeadlineAfterSpinning) {
+    SpinSyncType sync{4};
+    EXPECT_CALL(sync.getConditionVariable(), wait_until(_, _, _)).WillOnce(testing::Return(false));
+
+    bool callback_called{false};
+    EXPECT_FALSE(sync.waitForThenExecute(
+    std::chrono::milliseconds{5},
+    []() { return false; },
+    [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; }));
+    EXPECT_FALSE(callback_called);
+    EXPECT_THAT(sync.getParkedThreads(), testing::Eq(0U));
+}
+
+TEST_F(SpinSyncTests, TimedWaitExecutesCallableWhenPredicateHolds) {
+    EXPECT_CALL(condition_variable_mock, wait_until(_, _, _)).Times(0);
+
+    bool callback_called{false};
+    EXPECT_TRUE(m_sync.waitForThenExecute(
+    std::chrono::milliseconds{5},
+    []() { return true; },
+    [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; }));
+    EXPECT_TRUE(callback_called);
+}
+
+TEST_F(SpinSyncTests, ChangeSpinBudget) {
+    EXPECT_THAT(m_sync.getSpinBudget(), testing::Eq(SpinSyncType::default_spin_budget));
+    m_sync.setSpinBudget(10);
+    EXPECT_THAT(m_sync.getSpinBudget(), testing::Eq(10U));
+}
+
+TEST_F(SpinSyncTests, NotifyParkedThreads) {
+    SpinSyncType sync{0};
+    EXPECT_CALL(sync.getConditionVariable(), wait(_, _))
+    .WillOnce([&sync](std::unique_lock<NiceMutexMock>&, std::function<bool()>) {
+        EXPECT_THAT(sync.getParkedThreads(), testing::Eq(1U));
+        sync.notifyOne();
+        sync.notifyAll();
+    });
+    EXPECT_CALL(sync.getConditionVariable(), notify_one());
+    EXPECT_CALL(sync.getConditionVariable(), notify_all());
+
+    sync.waitThenExecute([]() { return false; }, [](std::unique_lock<NiceMutexMock>&) {});
+    EXPECT_THAT(sync.getParkedThreads(), testing::Eq(0U));
+}
+
+TEST_F(SpinSyncTests, SkipNotificationsWhenNoThreadIsParked) {
+    EXPECT_CALL(condition_variable_mock, notify_one()).Times(0);
+    EXPECT_CALL(condition_variable_mock, notify_all()).Times(0);
+
+    m_sync.notifyOne();
+    m_sync.notifyAll();
+}
+
+TEST_F(SpinSyncTests, ExecuteCodeLockedBySyncMutex) {
+    testing::Sequence s{};
+    EXPECT_CALL(mutex_mock, lock()).InSequence(s);
+    EXPECT_CALL(mutex_mock, unlock()).InSequence(s);
+
+    bool function_called{false};
+    m_sync.executeLocked([&function_called] { function_called = true; });
+
+    EXPECT_TRUE(function_called);
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/strand.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::Eq;
+using testing::IsNull;
+using testing::NotNull;
+
+class StrandRegistryTests : public testing::Test {
+protected:
+    pool_party::detail::StrandRegistry<int> m_registry{};
+};
+
+TEST_F(StrandRegistryTests, OnlyPushToIdleStrandRequiresScheduling) {
+    auto strand{m_registry.push(pool_party::detail::StrandKey{1}, 1)};
+    ASSERT_THAT(strand, NotNull());
+    EXPECT_THAT(m_registry.push(pool_party::detail::StrandKey{1}, 2), IsNull());
+    EXPECT_THAT(m_registry.push(pool_party::detail::StrandKey{2}, 3), NotNull());
+    EXPECT_THAT(m_registry.size(), Eq(2U));
+
+    EXPECT_THAT(strand->pop(), Eq(1));
+    EXPECT_THAT(strand->pop(), Eq(2));
+}
+
+TEST_F(StrandRegistryTests, OwnerKeepsStrandWhileTasksArePending) {
+    auto strand{m_registry.push(pool_party::detail::StrandKey{1}, 1)};
+    m_registry.push(pool_party::detail::StrandKey{1}, 2);
+
+    strand->pop();
+    EXPECT_TRUE(strand->hasMoreTasks(1));
+    EXPECT_FALSE(m_registry.release(strand, 1));
+
+    strand->pop();
+    EXPECT_FALSE(strand->hasMoreTasks(1));
+    EXPECT_TRUE(m_registry.release(strand, 1));
+}
+
+TEST_F(StrandRegistryTests, IdleStrandIsDropped) {
+    auto strand{m_registry.push(pool_party::detail::StrandKey{1}, 1)};
+    strand->pop();
+    ASSERT_TRUE(m_registry.release(strand, 1));
+    EXPECT_THAT(m_registry.size(), Eq(0U));
+
+    EXPECT_THAT(m_registry.push(pool_party::detail::StrandKey{1}, 2), NotNull());
+}
+
+TEST_F(StrandRegistryTests, DiscardDropsAllPendingTasks) {
+    auto strand{m_registry.push(pool_party::detail::StrandKey{1}, 1)};
+    m_registry.push(pool_party::detail::StrandKey{1}, 2);
+
+    m_registry.discard(strand);
+    EXPECT_TRUE(strand->isIdle());
+    EXPECT_THAT(m_registry.size(), Eq(0U));
+}
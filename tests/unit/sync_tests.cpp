@@ -25,6 +25,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <functional>
 #include <mutex>
 
@@ -41,6 +42,7 @@ using NiceMutexMock = testing::NiceMock<MutexMock>;
 class ConditionVariableMock {
 public:
     MOCK_METHOD(void, wait, (std::unique_lock<NiceMutexMock>&, std::function<bool()>) );
+    MOCK_METHOD(bool, wait_for, (std::unique_lock<NiceMutexMock>&, std::chrono::milliseconds, std::function<bool()>) );
     MOCK_METHOD(void, notify_one, ());
     MOCK_METHOD(void, notify_all, ());
 };
@@ -55,7 +57,7 @@ protected:
 };
 
 TEST_F(SyncTests, WaitForNotificationAndExecuteCallable) {
-    auto predicate_function{[]() { return true; }};
+    auto predicate_function{[]() { return false; }};
 
     testing::Sequence s{};
     EXPECT_CALL(mutex_mock, lock()).InSequence(s);
@@ -69,24 +71,77 @@ TEST_F(SyncTests, WaitForNotificationAndExecuteCallable) {
     EXPECT_TRUE(callback_called);
 }
 
+TEST_F(SyncTests, TimedWaitExecutesCallableWhenPredicateBecomesTrue) {
+    EXPECT_CALL(condition_variable_mock, wait_for(_, std::chrono::milliseconds{5}, _)).WillOnce(testing::Return(true));
+
+    bool callback_called{false};
+    EXPECT_TRUE(m_sync.waitForThenExecute(
+    std::chrono::milliseconds{5},
+    []() { return false; },
+    [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; }));
+    EXPECT_TRUE(callback_called);
+    EXPECT_THAT(m_sync.getParkedThreads(), testing::Eq(0U));
+}
+
+TEST_F(SyncTests, TimedWaitSkipsCallableOnTimeout) {
+    EXPECT_CALL(condition_variable_mock, wait_for(_, _, _)).WillOnce(testing::Return(false));
+
+    bool callback_called{false};
+    EXPECT_FALSE(m_sync.waitForThenExecute(
+    std::chrono::milliseconds{5},
+    []() { return false; },
+    [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; }));
+    EXPECT_FALSE(callback_called);
+}
+
 TEST_F(SyncTests, IsPredicateFunctionPassedToCVWait) {
-    bool predicate_function_called{false};
-    auto predicate_function{[&predicate_function_called]() {
-        predicate_function_called = true;
-        return true;
+    int predicate_function_calls{0};
+    auto predicate_function{[&predicate_function_calls]() {
+        ++predicate_function_calls;
+        return predicate_function_calls > 1;
     }};
 
     EXPECT_CALL(condition_variable_mock, wait(_, _))
-    .WillOnce([](std::unique_lock<NiceMutexMock>&, std::function<bool()> func) { func(); });
+    .WillOnce([](std::unique_lock<NiceMutexMock>&, std::function<bool()> func) { EXPECT_TRUE(func()); });
 
     m_sync.waitThenExecute(predicate_function, [](std::unique_lock<NiceMutexMock>&) {});
 
-    EXPECT_TRUE(predicate_function_called);
+    EXPECT_THAT(predicate_function_calls, testing::Eq(2));
+}
+
+TEST_F(SyncTests, DontWaitWhenPredicateHolds) {
+    EXPECT_CALL(condition_variable_mock, wait(_, _)).Times(0);
+
+    bool callback_called{false};
+    m_sync.waitThenExecute([]() { return true; },
+                           [&callback_called](std::unique_lock<NiceMutexMock>&) { callback_called = true; });
+    EXPECT_TRUE(callback_called);
+}
+
+TEST_F(SyncTests, CountParkedThreads) {
+    EXPECT_CALL(condition_variable_mock, wait(_, _))
+    .WillOnce([this](std::unique_lock<NiceMutexMock>&, std::function<bool()>) {
+        EXPECT_THAT(m_sync.getParkedThreads(), testing::Eq(1U));
+    });
+
+    m_sync.waitThenExecute([]() { return false; }, [](std::unique_lock<NiceMutexMock>&) {});
+    EXPECT_THAT(m_sync.getParkedThreads(), testing::Eq(0U));
 }
 
 TEST_F(SyncTests, NotifyWaitingThread) {
+    EXPECT_CALL(condition_variable_mock, wait(_, _))
+    .WillOnce([this](std::unique_lock<NiceMutexMock>&, std::function<bool()>) { m_sync.notifyOne(); });
     EXPECT_CALL(condition_variable_mock, notify_one());
+
+    m_sync.waitThenExecute([]() { return false; }, [](std::unique_lock<NiceMutexMock>&) {});
+}
+
+TEST_F(SyncTests, SkipNotificationsWhenNoThreadIsParked) {
+    EXPECT_CALL(condition_variable_mock, notify_one()).Times(0);
+    EXPECT_CALL(condition_variable_mock, notify_all()).Times(0);
+
     m_sync.notifyOne();
+    m_sync.notifyAll();
 }
 
 TEST_F(SyncTests, ExecuteCodeLockedBySyncMutex) {
@@ -101,6 +156,9 @@ TEST_F(SyncTests, ExecuteCodeLockedBySyncMutex) {
 }
 
 TEST_F(SyncTests, NotifyAllWaitingThreads) {
+    EXPECT_CALL(condition_variable_mock, wait(_, _))
+    .WillOnce([this](std::unique_lock<NiceMutexMock>&, std::function<bool()>) { m_sync.notifyAll(); });
     EXPECT_CALL(condition_variable_mock, notify_all());
-    m_sync.notifyAll();
+
+    m_sync.waitThenExecute([]() { return false; }, [](std::unique_lock<NiceMutexMock>&) {});
 }
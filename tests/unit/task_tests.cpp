@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/task.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <utility>
+
+using testing::Eq;
+
+namespace {
+class LargeCallable {
+public:
+    explicit LargeCallable(int& counter) : m_counter{counter} {}
+
+    void operator()() {
+        ++m_counter.get();
+    }
+
+private:
+    std::reference_wrapper<int> m_counter;
+    std::array<char, 2 * pool_party::detail::Task::inline_capacity> m_payload{};
+};
+}  // namespace
+
+class TaskTests : public testing::Test {};
+
+TEST_F(TaskTests, DefaultConstructedTaskIsEmpty) {
+    pool_party::detail::Task task{};
+    EXPECT_FALSE(task);
+}
+
+TEST_F(TaskTests, CallWrappedCallable) {
+    int counter{0};
+    pool_party::detail::Task task{[&counter]() { ++counter; }};
+
+    EXPECT_TRUE(task);
+    task();
+    EXPECT_THAT(counter, Eq(1));
+}
+
+TEST_F(TaskTests, SmallCallablesAreStoredInline) {
+    auto small_callable{[]() {}};
+    EXPECT_TRUE(pool_party::detail::Task::isStoredInline<decltype(small_callable)>());
+    EXPECT_TRUE(pool_party::detail::Task::isStoredInline<std::packaged_task<int()>>());
+    EXPECT_FALSE(pool_party::detail::Task::isStoredInline<LargeCallable>());
+}
+
+TEST_F(TaskTests, InlineCapacityIsDefinedForReferences) {
+    const std::size_t& inline_capacity{pool_party::detail::Task::inline_capacity};
+    EXPECT_THAT(inline_capacity, Eq(48U));
+}
+
+TEST_F(TaskTests, CallLargeCallableStoredOnHeap) {
+    int counter{0};
+    pool_party::detail::Task task{LargeCallable{counter}};
+
+    task();
+    EXPECT_THAT(counter, Eq(1));
+}
+
+TEST_F(TaskTests, MoveTaskLeavesSourceEmpty) {
+    int counter{0};
+    pool_party::detail::Task inline_task{[&counter]() { ++counter; }};
+    pool_party::detail::Task heap_task{LargeCallable{counter}};
+
+    pool_party::detail::Task moved_inline_task{std::move(inline_task)};
+    pool_party::detail::Task moved_heap_task{};
+    moved_heap_task = std::move(heap_task);
+
+    EXPECT_FALSE(inline_task);
+    EXPECT_FALSE(heap_task);
+    moved_inline_task();
+    moved_heap_task();
+    EXPECT_THAT(counter, Eq(2));
+}
+
+TEST_F(TaskTests, WrapMoveOnlyCallable) {
+    std::packaged_task<int()> packaged_task{[]() { return 42; }};
+    auto future{packaged_task.get_future()};
+
+    pool_party::detail::Task task{std::move(packaged_task)};
+    task();
+    EXPECT_THAT(future.get(), Eq(42));
+}
+
+TEST_F(TaskTests, ReleaseCallableOnDestruction) {
+    auto shared_value{std::make_shared<int>(0)};
+    {
+        pool_party::detail::Task task{[shared_value]() {}};
+        EXPECT_THAT(shared_value.use_count(), Eq(2));
+    }
+    EXPECT_THAT(shared_value.use_count(), Eq(1));
+}
@@ -20,15 +20,26 @@
  * SOFTWARE.
  */
 
+#include "pool_party/detail/lifo_slot_queue.hpp"
+#include "pool_party/detail/mpmc_ring_queue.hpp"
+#include "pool_party/detail/numa_queue.hpp"
+#include "pool_party/detail/priority_queue.hpp"
 #include "pool_party/detail/thread_pool.hpp"
+#include "pool_party/detail/work_stealing_queue.hpp"
 
 #include "mocks/joinable_mock.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <functional>
+#include <future>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 using testing::_;
 
@@ -51,6 +62,10 @@ class SyncMock {
 public:
     using mutex_type = NiceMutexMock;
     MOCK_METHOD(void, waitThenExecute, (std::function<bool()>, std::function<void(UniqueLock &)>) );
+    MOCK_METHOD(bool,
+                waitForThenExecute,
+                (std::chrono::nanoseconds, std::function<bool()>, std::function<void(UniqueLock &)>) );
+    MOCK_METHOD(std::size_t, getParkedThreads, (), (const));
     MOCK_METHOD(void, notifyOne, ());
     MOCK_METHOD(void, notifyAll, ());
     MOCK_METHOD(void, executeLocked, (std::function<void()>) );
@@ -81,12 +96,15 @@ protected:
         });
     }
 
-    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> createPool() {
-        pool_party::detail::ThreadPool created_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    /// The pool owns a mutex and its workers refer to it, so it is created on the heap
+    std::unique_ptr<pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock>> createPool() {
+        std::unique_ptr<pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock>> created_pool{
+        new pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock>{
+        m_thread_count, m_thread_factory_mock, m_sync_mock}};
 
+        auto &pool{*created_pool};
         ON_CALL(m_sync_mock, waitThenExecute(_, _))
-        .WillByDefault(
-        [&created_pool](std::function<bool()>, std::function<void(UniqueLock &)>) { created_pool.shutdown(); });
+        .WillByDefault([&pool](std::function<bool()>, std::function<void(UniqueLock &)>) { pool.shutdown(); });
 
         return created_pool;
     }
@@ -103,6 +121,15 @@ protected:
         container.front()();
     }
 
+    void activateWaitingForEachTask(pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> &tp) {
+        EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+        .WillRepeatedly([this, &tp](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+            UniqueLock lock{m_mutex_mock};
+            wait_callable(lock);
+            tp.shutdown();
+        });
+    }
+
     void activateWaiting(pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> &tp) {
         EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
         .WillRepeatedly([this, &tp](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
@@ -117,14 +144,24 @@ TEST_F(ThreadPoolTests, CreatedNumberOfThreads) {
     createPool();
 }
 
+TEST_F(ThreadPoolTests, TimerThreadIsNotCreatedByThreadFactory) {
+    EXPECT_CALL(m_thread_factory_mock, create(_)).Times(m_thread_count);
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    thread_pool.scheduleAfter(std::chrono::hours{1}, []() {});
+}
+
 TEST_F(ThreadPoolTests, AddingTaskToThreadPoolNotifiesThread) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
     EXPECT_CALL(m_sync_mock, notifyOne());
     thread_pool.enqueue([]() {});
 }
 
 TEST_F(ThreadPoolTests, ProcessingEnqueuedTask) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
     activateWaiting(thread_pool);
 
     const int task_result{5};
@@ -135,7 +172,8 @@ TEST_F(ThreadPoolTests, ProcessingEnqueuedTask) {
 }
 
 TEST_F(ThreadPoolTests, ReleaseLockBeforeProcessingEnqueuedTask) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
     activateWaiting(thread_pool);
 
     EXPECT_CALL(m_mutex_mock, unlock());
@@ -148,7 +186,8 @@ TEST_F(ThreadPoolTests, ReleaseLockBeforeProcessingEnqueuedTask) {
 }
 
 TEST_F(ThreadPoolTests, KeepWaitingWhenNoTaskIsAvailable) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
 
     EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
     .WillOnce([&thread_pool](std::function<bool()> predicate, std::function<void(UniqueLock &)>) {
@@ -160,7 +199,8 @@ TEST_F(ThreadPoolTests, KeepWaitingWhenNoTaskIsAvailable) {
 }
 
 TEST_F(ThreadPoolTests, StopWaitingWhenPoolIsShutDown) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
 
     EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
     .WillOnce([&thread_pool](std::function<bool()> predicate, std::function<void(UniqueLock &)>) {
@@ -172,7 +212,8 @@ TEST_F(ThreadPoolTests, StopWaitingWhenPoolIsShutDown) {
 }
 
 TEST_F(ThreadPoolTests, FinishWorkWhenThreadPoolWasShutDown) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
 
     EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
     .WillOnce(
@@ -189,7 +230,8 @@ TEST_F(ThreadPoolTests, FinishWorkWhenThreadPoolWasShutDown) {
 }
 
 TEST_F(ThreadPoolTests, PreventQueueProcessingWhenShutdownAndWorkDone) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
 
     EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
     .WillOnce([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
@@ -201,14 +243,16 @@ TEST_F(ThreadPoolTests, PreventQueueProcessingWhenShutdownAndWorkDone) {
 }
 
 TEST_F(ThreadPoolTests, ShutdownNotifiesAllThreads) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
     // notifyAll is called manually on shutdown() and on destruction of the thread_pool object.
     EXPECT_CALL(m_sync_mock, notifyAll()).Times(2);
     thread_pool.shutdown();
 }
 
 TEST_F(ThreadPoolTests, DontEnqueueTasksAfterShutdown) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
     thread_pool.shutdown();
 
     EXPECT_THROW(
@@ -224,7 +268,8 @@ TEST_F(ThreadPoolTests, DontEnqueueTasksAfterShutdown) {
 }
 
 TEST_F(ThreadPoolTests, TaskOrderIsFifo) {
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
 
     int task_index{0};
     thread_pool.enqueue([&task_index]() { task_index = 1; });
@@ -248,7 +293,638 @@ TEST_F(ThreadPoolTests, TaskOrderIsFifo) {
     executeFirst(m_worker_functions);
 }
 
+TEST_F(ThreadPoolTests, WorkerExecutesShareOfQueuedTasksPerLockAcquisition) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    const int task_count{8};
+    int executed_tasks{0};
+    thread_pool.enqueueBulk(task_count, [&executed_tasks](std::size_t) { ++executed_tasks; });
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillOnce(
+    [&thread_pool, &executed_tasks, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        UniqueLock ul{m_mutex_mock};
+        wait_callable(ul);
+        // Each of the four workers takes a quarter of the eight queued tasks
+        EXPECT_THAT(executed_tasks, testing::Eq(2));
+        thread_pool.shutdown();
+    })
+    .WillRepeatedly([this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        UniqueLock ul{m_mutex_mock};
+        wait_callable(ul);
+    });
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(executed_tasks, testing::Eq(task_count));
+}
+
+TEST_F(ThreadPoolTests, TaskWithHigherPriorityIsProcessedFirst) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::PriorityQueue> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock};
+
+    std::vector<int> processed_tasks{};
+    thread_pool.post(pool_party::detail::Priority::low, [&processed_tasks]() { processed_tasks.push_back(1); });
+    thread_pool.enqueue([&processed_tasks]() { processed_tasks.push_back(2); });
+    thread_pool.post(pool_party::detail::Priority::critical, [&processed_tasks]() { processed_tasks.push_back(3); });
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillRepeatedly([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        UniqueLock ul{m_mutex_mock};
+        wait_callable(ul);
+        thread_pool.shutdown();
+    });
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(processed_tasks, testing::ElementsAre(3, 2, 1));
+}
+
+TEST_F(ThreadPoolTests, CriticalTaskOvertakesQueuedTasksOfLowerPriority) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::PriorityQueue> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock};
+
+    // Enough tasks for a batch per worker, the first one pushes the critical task
+    std::vector<int> processed_tasks{};
+    thread_pool.post(pool_party::detail::Priority::low, [&thread_pool, &processed_tasks]() {
+        processed_tasks.push_back(0);
+        thread_pool.post(pool_party::detail::Priority::critical,
+                         [&processed_tasks]() { processed_tasks.push_back(-1); });
+    });
+    for (int i{1}; i < 3 * static_cast<int>(m_thread_count); ++i) {
+        thread_pool.post(pool_party::detail::Priority::low, [&processed_tasks, i]() { processed_tasks.push_back(i); });
+    }
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillRepeatedly([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        UniqueLock ul{m_mutex_mock};
+        wait_callable(ul);
+        thread_pool.shutdown();
+    });
+
+    executeFirst(m_worker_functions);
+    ASSERT_THAT(processed_tasks.size(), testing::Ge(2U));
+    EXPECT_THAT(processed_tasks[1], testing::Eq(-1));
+}
+
+TEST_F(ThreadPoolTests, IdleWorkerParksWhileOnlyReservedSlotTasksAreQueued) {
+    const std::chrono::nanoseconds steal_delay{pool_party::detail::LifoSlotQueue<int>::steal_delay};
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::LifoSlotQueue> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock};
+
+    // The first worker fills its slot and lets the second worker look for tasks meanwhile
+    bool is_follow_up_processed{false};
+    thread_pool.post([&thread_pool, &is_follow_up_processed, this]() {
+        thread_pool.post([&is_follow_up_processed]() { is_follow_up_processed = true; });
+        m_worker_functions[1]();
+    });
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillRepeatedly([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        UniqueLock ul{m_mutex_mock};
+        wait_callable(ul);
+        thread_pool.shutdown();
+    });
+    const auto is_within_steal_delay{
+    testing::AllOf(testing::Gt(std::chrono::nanoseconds::zero()), testing::Le(steal_delay))};
+    EXPECT_CALL(m_sync_mock, waitForThenExecute(is_within_steal_delay, _, _)).Times(testing::AtLeast(1));
+
+    executeFirst(m_worker_functions);
+    EXPECT_TRUE(is_follow_up_processed);
+}
+
+TEST_F(ThreadPoolTests, TasksOfAStrandShareOnePoolTask) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    // Only the push which makes the strand busy schedules it
+    EXPECT_CALL(m_sync_mock, notifyOne()).Times(1);
+    std::vector<int> processed_tasks{};
+    thread_pool.post(pool_party::detail::StrandKey{1}, [&processed_tasks]() { processed_tasks.push_back(1); });
+    thread_pool.post(pool_party::detail::StrandKey{1}, [&processed_tasks]() { processed_tasks.push_back(2); });
+    auto future{thread_pool.enqueue(pool_party::detail::StrandKey{1}, []() { return 3; })};
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(processed_tasks, testing::ElementsAre(1, 2));
+    EXPECT_THAT(future.get(), testing::Eq(3));
+}
+
+TEST_F(ThreadPoolTests, DontEnqueueStrandTasksAfterShutdown) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    thread_pool.shutdown();
+
+    EXPECT_THROW(thread_pool.enqueue(pool_party::detail::StrandKey{1}, []() {}), std::runtime_error);
+    EXPECT_THROW(thread_pool.enqueue(pool_party::detail::StrandKey{1}, []() {}), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests, ShutdownNowHandsBackQueuedTasks) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    auto first{thread_pool.enqueue([]() { return 1; })};
+    auto second{thread_pool.enqueue([]() { return 2; })};
+    auto tasks{thread_pool.shutdownNow()};
+    ASSERT_THAT(tasks.size(), testing::Eq(2U));
+    EXPECT_FALSE(thread_pool.tryExecuteTask());
+    EXPECT_THROW(thread_pool.enqueue([]() {}), std::runtime_error);
+
+    tasks.front()();
+    EXPECT_THAT(first.get(), testing::Eq(1));
+    tasks.clear();
+    EXPECT_THROW(second.get(), std::future_error);
+}
+
+TEST_F(ThreadPoolTests, ShutdownNowHandsBackRestOfTakenBatch) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    // Each of the four workers takes a batch of three tasks
+    const std::size_t task_count{3 * m_thread_count};
+    std::size_t executed_tasks{0};
+    std::vector<pool_party::detail::Task> tasks{};
+    thread_pool.post([&thread_pool, &executed_tasks, &tasks]() {
+        ++executed_tasks;
+        tasks = thread_pool.shutdownNow();
+    });
+    for (std::size_t i{1}; i < task_count; ++i) {
+        thread_pool.post([&executed_tasks]() { ++executed_tasks; });
+    }
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(executed_tasks, testing::Eq(1U));
+    ASSERT_THAT(tasks.size(), testing::Eq(task_count - 1));
+    for (auto &task : tasks) {
+        task();
+    }
+    EXPECT_THAT(executed_tasks, testing::Eq(task_count));
+}
+
+TEST_F(ThreadPoolTests, HandedBackStrandTaskExecutesAllTasksOfTheStrand) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    // More tasks than a strand executes before it is handed over
+    const int task_count{40};
+    std::vector<int> processed_tasks{};
+    for (int i{0}; i < task_count; ++i) {
+        thread_pool.post(pool_party::detail::StrandKey{1}, [&processed_tasks, i]() { processed_tasks.push_back(i); });
+    }
+    auto tasks{thread_pool.shutdownNow()};
+    ASSERT_THAT(tasks.size(), testing::Eq(1U));
+
+    tasks.front()();
+    ASSERT_THAT(processed_tasks.size(), testing::Eq(static_cast<std::size_t>(task_count)));
+    EXPECT_TRUE(std::is_sorted(processed_tasks.begin(), processed_tasks.end()));
+}
+
+TEST_F(ThreadPoolTests, DroppedSubmittedTaskReportsBrokenPromise) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    auto future{thread_pool.submit([]() { return 1; })};
+    auto tasks{thread_pool.shutdownNow()};
+    ASSERT_THAT(tasks.size(), testing::Eq(1U));
+    EXPECT_FALSE(future.isReady());
+
+    tasks.clear();
+    ASSERT_TRUE(future.isReady());
+    EXPECT_THROW(future.get(), std::future_error);
+}
+
+TEST_F(ThreadPoolTests, WorkerStopsWithoutProcessingAfterShutdownNow) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    bool task_executed{false};
+    thread_pool.post([&task_executed]() { task_executed = true; });
+    EXPECT_THAT(thread_pool.shutdownNow().size(), testing::Eq(1U));
+
+    executeFirst(m_worker_functions);
+    EXPECT_FALSE(task_executed);
+}
+
+TEST_F(ThreadPoolTests, PoolIsIdleAfterQueuedTasksAreExecuted) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaitingForEachTask(thread_pool);
+    EXPECT_TRUE(thread_pool.waitIdleFor(std::chrono::milliseconds{0}));
+
+    thread_pool.post([]() {});
+    auto future{thread_pool.enqueue([]() { return 1; })};
+    EXPECT_FALSE(thread_pool.waitIdleFor(std::chrono::milliseconds{0}));
+
+    executeFirst(m_worker_functions);
+    EXPECT_TRUE(thread_pool.waitIdleFor(std::chrono::milliseconds{0}));
+    thread_pool.waitIdle();
+}
+
+TEST_F(ThreadPoolTests, PoolIsIdleAfterShutdownNowHandsBackQueuedTasks) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+
+    thread_pool.post([]() {});
+    EXPECT_FALSE(thread_pool.waitIdleFor(std::chrono::milliseconds{0}));
+    EXPECT_THAT(thread_pool.shutdownNow().size(), testing::Eq(1U));
+    EXPECT_TRUE(thread_pool.waitIdleFor(std::chrono::milliseconds{0}));
+}
+
 TEST_F(ThreadPoolTests, ShutdownPoolWhileDestruction) {
     EXPECT_CALL(m_sync_mock, notifyAll());
-    auto thread_pool{createPool()};
+    auto created_pool{createPool()};
+}
+
+TEST_F(ThreadPoolTests, ProcessingPostedTask) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    bool task_executed{false};
+    thread_pool.post([&task_executed](bool executed) { task_executed = executed; }, true);
+
+    executeFirst(m_worker_functions);
+    EXPECT_TRUE(task_executed);
+}
+
+TEST_F(ThreadPoolTests, PassExceptionOfPostedTaskToHandler) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    std::exception_ptr handled_exception{};
+    thread_pool.setExceptionHandler([&handled_exception](std::exception_ptr e) { handled_exception = e; });
+    thread_pool.post([]() { throw std::logic_error{"task failed"}; });
+
+    executeFirst(m_worker_functions);
+    ASSERT_TRUE(handled_exception);
+    EXPECT_THROW(std::rethrow_exception(handled_exception), std::logic_error);
+}
+
+TEST_F(ThreadPoolTests, TerminateWhenPostedTaskThrowsWithoutHandler) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    thread_pool.post([]() { throw std::logic_error{"task failed"}; });
+
+    EXPECT_DEATH(executeFirst(m_worker_functions), "");
+}
+
+TEST_F(ThreadPoolTests, DontPostTasksAfterShutdown) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    thread_pool.shutdown();
+
+    EXPECT_THROW(thread_pool.post([]() {}), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests, SkipCancelledEnqueuedTask) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    pool_party::detail::CancellationSource source{};
+    bool task_executed{false};
+    auto future{thread_pool.enqueue(source.getToken(), [&task_executed]() { task_executed = true; })};
+    source.cancel();
+
+    executeFirst(m_worker_functions);
+    EXPECT_FALSE(task_executed);
+    EXPECT_THROW(future.get(), pool_party::detail::TaskCancelled);
+}
+
+TEST_F(ThreadPoolTests, SkipCancelledPostedTaskWithoutCallingHandler) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaiting(thread_pool);
+
+    bool exception_handled{false};
+    thread_pool.setExceptionHandler([&exception_handled](std::exception_ptr) { exception_handled = true; });
+    pool_party::detail::CancellationSource source{};
+    bool task_executed{false};
+    thread_pool.post(source.getToken(), [&task_executed](bool executed) { task_executed = executed; }, true);
+    source.cancel();
+
+    executeFirst(m_worker_functions);
+    EXPECT_FALSE(task_executed);
+    EXPECT_FALSE(exception_handled);
+}
+
+TEST_F(ThreadPoolTests, EnqueueBulkLocksOnceAndNotifiesThreadPerTask) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    EXPECT_CALL(m_sync_mock, executeLocked(_)).Times(1);
+    EXPECT_CALL(m_sync_mock, notifyOne()).Times(2);
+
+    std::vector<std::function<void()>> tasks{[]() {}, []() {}};
+    thread_pool.enqueueBulk(tasks.begin(), tasks.end());
+    testing::Mock::VerifyAndClearExpectations(&m_sync_mock);
+}
+
+TEST_F(ThreadPoolTests, EnqueueBulkNotifiesAllThreadsWhenTasksOutnumberThem) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    EXPECT_CALL(m_sync_mock, notifyOne()).Times(0);
+    EXPECT_CALL(m_sync_mock, notifyAll());
+
+    thread_pool.enqueueBulk(m_thread_count, [](std::size_t) {});
+    testing::Mock::VerifyAndClearExpectations(&m_sync_mock);
+}
+
+TEST_F(ThreadPoolTests, ProcessingBulkEnqueuedTasks) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaitingForEachTask(thread_pool);
+
+    auto futures{thread_pool.enqueueBulk(3, [](std::size_t task_index) { return task_index * 2; })};
+
+    executeFirst(m_worker_functions);
+    ASSERT_THAT(futures.size(), testing::Eq(3U));
+    for (std::size_t task_index{0}; task_index < futures.size(); ++task_index) {
+        EXPECT_THAT(futures[task_index].get(), testing::Eq(task_index * 2));
+    }
+}
+
+TEST_F(ThreadPoolTests, ProcessingBulkPostedTasks) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    activateWaitingForEachTask(thread_pool);
+
+    int task_sum{0};
+    std::vector<std::function<void()>> tasks{[&task_sum]() { task_sum += 1; }, [&task_sum]() { task_sum += 2; }};
+    thread_pool.postBulk(tasks.begin(), tasks.end());
+    thread_pool.postBulk(2, [&task_sum](std::size_t task_index) { task_sum += static_cast<int>(task_index); });
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(task_sum, testing::Eq(4));
+}
+
+TEST_F(ThreadPoolTests, DontEnqueueBulkAfterShutdown) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    thread_pool.shutdown();
+
+    EXPECT_THROW(thread_pool.enqueueBulk(2, [](std::size_t) {}), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests, CallerExecutesPendingTask) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    auto future{thread_pool.enqueue([]() { return 5; })};
+
+    EXPECT_TRUE(thread_pool.tryExecuteTask());
+    EXPECT_THAT(future.wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
+    EXPECT_FALSE(thread_pool.tryExecuteTask());
+}
+
+TEST_F(ThreadPoolTests, ElasticPoolStartsWithMinimumOfWorkers) {
+    EXPECT_CALL(m_thread_factory_mock, create(_)).Times(2);
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    pool_party::detail::ElasticLimits{2, 4}, m_thread_factory_mock, m_sync_mock};
+
+    EXPECT_THAT(thread_pool.getNumberOfThreads(), testing::Eq(2U));
+}
+
+TEST_F(ThreadPoolTests, ElasticPoolRejectsInvalidLimits) {
+    using PoolType = pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock>;
+
+    EXPECT_THROW(PoolType(pool_party::detail::ElasticLimits{0, 4}, m_thread_factory_mock, m_sync_mock),
+                 std::invalid_argument);
+    EXPECT_THROW(PoolType(pool_party::detail::ElasticLimits{3, 2}, m_thread_factory_mock, m_sync_mock),
+                 std::invalid_argument);
+}
+
+TEST_F(ThreadPoolTests, ElasticPoolGrowsUpToMaximumWhileNoWorkerIsParked) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    pool_party::detail::ElasticLimits{1, 3}, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(0));
+
+    for (int task{0}; task < 4; ++task) {
+        thread_pool.post([]() {});
+    }
+
+    EXPECT_THAT(m_worker_functions.size(), testing::Eq(3U));
+    EXPECT_THAT(thread_pool.getNumberOfThreads(), testing::Eq(3U));
+}
+
+TEST_F(ThreadPoolTests, ElasticPoolDoesntGrowWhileWorkersAreParked) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    pool_party::detail::ElasticLimits{1, 3}, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(1));
+
+    thread_pool.post([]() {});
+
+    EXPECT_THAT(m_worker_functions.size(), testing::Eq(1U));
+}
+
+TEST_F(ThreadPoolTests, ElasticPoolGrowsOnlyAboveBacklogThreshold) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    pool_party::detail::ElasticLimits{1, 3, std::chrono::seconds{1}, 3}, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(0));
+
+    thread_pool.post([]() {});
+    thread_pool.post([]() {});
+    EXPECT_THAT(m_worker_functions.size(), testing::Eq(1U));
+
+    thread_pool.post([]() {});
+    EXPECT_THAT(m_worker_functions.size(), testing::Eq(2U));
+}
+
+TEST_F(ThreadPoolTests, IdleWorkerAboveMinimumRetiresAfterKeepAlive) {
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    pool_party::detail::ElasticLimits{1, 2, std::chrono::milliseconds{10}}, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(0));
+    thread_pool.post([]() {});
+    ASSERT_THAT(m_worker_functions.size(), testing::Eq(2U));
+    thread_pool.tryExecuteTask();
+
+    EXPECT_CALL(m_sync_mock, waitForThenExecute(std::chrono::nanoseconds{std::chrono::milliseconds{10}}, _, _))
+    .WillOnce(testing::Return(false));
+    m_worker_functions[1]();
+    EXPECT_THAT(thread_pool.getNumberOfThreads(), testing::Eq(1U));
+
+    // The last worker keeps waiting at the minimum
+    EXPECT_CALL(m_sync_mock, waitForThenExecute(_, _, _))
+    .WillOnce(testing::Return(false))
+    .WillOnce([&thread_pool](std::chrono::nanoseconds, std::function<bool()>, std::function<void(UniqueLock &)>) {
+        thread_pool.shutdown();
+        return false;
+    });
+    m_worker_functions[0]();
+    EXPECT_THAT(thread_pool.getNumberOfThreads(), testing::Eq(1U));
+}
+
+TEST_F(ThreadPoolTests, FixedPoolWaitsWithoutTimeout) {
+    auto created_pool{createPool()};
+    auto &thread_pool{*created_pool};
+    EXPECT_CALL(m_sync_mock, waitForThenExecute(_, _, _)).Times(0);
+    EXPECT_CALL(m_sync_mock, getParkedThreads()).Times(0);
+    activateWaitingForEachTask(thread_pool);
+
+    thread_pool.post([]() {});
+    executeFirst(m_worker_functions);
+}
+
+TEST_F(ThreadPoolTests, TryEnqueueFailsWhileBoundedQueueIsFull) {
+    const std::size_t capacity{1};
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock, capacity};
+    auto first_future{thread_pool.enqueue([]() { return 1; })};
+
+    EXPECT_FALSE(thread_pool.tryEnqueue([]() { return 2; }).valid());
+    EXPECT_FALSE(thread_pool.enqueueFor(std::chrono::milliseconds{1}, []() { return 2; }).valid());
+
+    EXPECT_TRUE(thread_pool.tryExecuteTask());
+    auto second_future{thread_pool.tryEnqueue([]() { return 2; })};
+    ASSERT_TRUE(second_future.valid());
+    EXPECT_TRUE(thread_pool.tryExecuteTask());
+    EXPECT_THAT(first_future.get(), testing::Eq(1));
+    EXPECT_THAT(second_future.get(), testing::Eq(2));
+}
+
+TEST_F(ThreadPoolTests, WorkerExecutesPendingTaskWhenBoundedQueueIsFull) {
+    const std::size_t capacity{1};
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock, capacity};
+
+    std::future<int> second_future{};
+    std::future<int> third_future{};
+    auto first_future{thread_pool.enqueue([&thread_pool, &second_future, &third_future]() {
+        second_future = thread_pool.enqueue([]() { return 2; });
+        // The queue is full now, so the worker has to execute the second task itself
+        third_future = thread_pool.enqueue([]() { return 3; });
+        EXPECT_THAT(second_future.wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
+        return 1;
+    })};
+
+    activateWaitingForEachTask(thread_pool);
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(first_future.get(), testing::Eq(1));
+    EXPECT_THAT(second_future.get(), testing::Eq(2));
+    EXPECT_THAT(third_future.get(), testing::Eq(3));
+}
+
+class ConcurrentQueueThreadPoolTests : public ThreadPoolTests {
+protected:
+    using ConcurrentPoolType =
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::WorkStealingQueue>;
+};
+
+TEST_F(ConcurrentQueueThreadPoolTests, ProcessTasksWithoutWaitingForSync) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+
+    const int task_result{5};
+    auto future{thread_pool.enqueue([&task_result]() { return task_result; })};
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillOnce([&thread_pool, &future, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        EXPECT_THAT(future.wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
+        thread_pool.shutdown();
+        wait_callable(m_lock);
+    });
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(future.get(), testing::Eq(task_result));
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, AddingTaskNotifiesParkedThreadAfterPassingTheMutex) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(1));
+
+    testing::Sequence s{};
+    EXPECT_CALL(m_sync_mock, executeLocked(_)).InSequence(s);
+    EXPECT_CALL(m_sync_mock, notifyOne()).InSequence(s);
+    thread_pool.enqueue([]() {});
+    testing::Mock::VerifyAndClearExpectations(&m_sync_mock);
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, AddingTaskWithoutParkedThreadSkipsTheMutex) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    ON_CALL(m_sync_mock, getParkedThreads()).WillByDefault(testing::Return(0));
+
+    EXPECT_CALL(m_sync_mock, executeLocked(_)).Times(0);
+    thread_pool.post([]() {});
+    testing::Mock::VerifyAndClearExpectations(&m_sync_mock);
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, KeepWorkingUntilQueueIsDrained) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    thread_pool.enqueue([]() {});
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillOnce([&thread_pool, this](std::function<bool()> predicate, std::function<void(UniqueLock &)> wait_callable) {
+        thread_pool.shutdown();
+        EXPECT_TRUE(predicate());
+        wait_callable(m_lock);
+    });
+
+    executeFirst(m_worker_functions);
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, CallerExecutesPendingTask) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    auto future{thread_pool.enqueue([]() { return 5; })};
+
+    EXPECT_TRUE(thread_pool.tryExecuteTask());
+    EXPECT_THAT(future.get(), testing::Eq(5));
+    EXPECT_FALSE(thread_pool.tryExecuteTask());
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, DontEnqueueTasksAfterShutdown) {
+    ConcurrentPoolType thread_pool{m_thread_count, m_thread_factory_mock, m_sync_mock};
+    thread_pool.shutdown();
+
+    EXPECT_THROW(thread_pool.enqueue([]() {}), std::runtime_error);
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, WorkerExecutesPendingTaskWhenBoundedQueueIsFull) {
+    const std::size_t capacity{2};
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::MpmcRingQueue> thread_pool{
+    m_thread_count, m_thread_factory_mock, m_sync_mock, capacity};
+
+    std::future<int> first_future{};
+    std::future<int> second_future{};
+    std::future<int> third_future{};
+    std::future<int> fourth_future{};
+    first_future = thread_pool.enqueue([&thread_pool, &second_future, &third_future, &fourth_future]() {
+        second_future = thread_pool.enqueue([]() { return 2; });
+        third_future  = thread_pool.enqueue([]() { return 3; });
+        // The queue is full now, so the worker has to execute the second task itself
+        fourth_future = thread_pool.enqueue([]() { return 4; });
+        EXPECT_THAT(second_future.wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
+        return 1;
+    });
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillOnce([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        thread_pool.shutdown();
+        wait_callable(m_lock);
+    });
+
+    executeFirst(m_worker_functions);
+    EXPECT_THAT(first_future.get(), testing::Eq(1));
+    EXPECT_THAT(second_future.get(), testing::Eq(2));
+    EXPECT_THAT(third_future.get(), testing::Eq(3));
+    EXPECT_THAT(fourth_future.get(), testing::Eq(4));
+}
+
+TEST_F(ConcurrentQueueThreadPoolTests, EnqueueTaskForNumaNode) {
+    const std::vector<pool_party::detail::NumaNode> nodes{{0, {0}, {}}, {1, {1}, {}}};
+    pool_party::detail::ThreadPool<NiceThreadFactoryMock, NiceSyncMock, pool_party::detail::NumaQueue> thread_pool{
+    2, m_thread_factory_mock, m_sync_mock, nodes};
+
+    auto future{thread_pool.enqueueOn(1, []() { return 1; })};
+    EXPECT_THROW(thread_pool.postOn(2, []() {}), std::out_of_range);
+
+    EXPECT_CALL(m_sync_mock, waitThenExecute(_, _))
+    .WillOnce([&thread_pool, this](std::function<bool()>, std::function<void(UniqueLock &)> wait_callable) {
+        thread_pool.shutdown();
+        wait_callable(m_lock);
+    });
+
+    // Worker 1 belongs to node 1
+    m_worker_functions[1]();
+    EXPECT_THAT(future.wait_for(std::chrono::seconds{0}), testing::Eq(std::future_status::ready));
 }
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/timer_wheel.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using testing::ElementsAre;
+using testing::Eq;
+
+class TimerWheelTests : public testing::Test {
+protected:
+    pool_party::detail::TimerWheel<int> m_wheel{};
+    std::vector<int> m_fired{};
+
+    void advance(std::uint64_t now) {
+        m_wheel.advance(now, [this](int item) { m_fired.push_back(item); });
+    }
+};
+
+TEST_F(TimerWheelTests, TimerFiresAtDueTick) {
+    m_wheel.add(5, 0, 1);
+
+    advance(4);
+    EXPECT_TRUE(m_fired.empty());
+    advance(5);
+    EXPECT_THAT(m_fired, ElementsAre(1));
+    EXPECT_TRUE(m_wheel.empty());
+}
+
+TEST_F(TimerWheelTests, OverdueTimerFiresAtNextAdvance) {
+    advance(10);
+    m_wheel.add(3, 0, 1);
+
+    advance(11);
+    EXPECT_THAT(m_fired, ElementsAre(1));
+}
+
+TEST_F(TimerWheelTests, TimersCascadeFromHigherLevels) {
+    const std::uint64_t due_tick{3 * 64 * 64 + 5 * 64 + 7};
+    m_wheel.add(due_tick, 0, 1);
+
+    advance(due_tick - 1);
+    EXPECT_TRUE(m_fired.empty());
+    advance(due_tick);
+    EXPECT_THAT(m_fired, ElementsAre(1));
+}
+
+TEST_F(TimerWheelTests, TimersBeyondRangeFireAtDueTick) {
+    const std::uint64_t due_tick{(std::uint64_t{1} << 40) + 3};
+    m_wheel.add(due_tick, 0, 1);
+
+    advance(due_tick - 1);
+    EXPECT_TRUE(m_fired.empty());
+    advance(due_tick);
+    EXPECT_THAT(m_fired, ElementsAre(1));
+}
+
+TEST_F(TimerWheelTests, CancelledTimerDoesNotFire) {
+    const auto id{m_wheel.add(5, 0, 1)};
+    m_wheel.add(5, 0, 2);
+
+    EXPECT_TRUE(m_wheel.cancel(id));
+    EXPECT_FALSE(m_wheel.cancel(id));
+    advance(5);
+    EXPECT_THAT(m_fired, ElementsAre(2));
+}
+
+TEST_F(TimerWheelTests, HandleOfFiredTimerDoesNotCancelReusedStorage) {
+    const auto id{m_wheel.add(1, 0, 1)};
+    advance(1);
+    m_wheel.add(5, 0, 2);
+
+    EXPECT_FALSE(m_wheel.cancel(id));
+    advance(5);
+    EXPECT_THAT(m_fired, ElementsAre(1, 2));
+}
+
+TEST_F(TimerWheelTests, PeriodicTimerFiresEachPeriodAndSkipsMissedPeriods) {
+    const auto id{m_wheel.add(10, 10, 1)};
+
+    advance(10);
+    advance(20);
+    EXPECT_THAT(m_fired.size(), Eq(2U));
+
+    // Periods 30 to 90 were missed, the timer fires once and continues at 100
+    advance(95);
+    EXPECT_THAT(m_fired.size(), Eq(3U));
+    advance(99);
+    EXPECT_THAT(m_fired.size(), Eq(3U));
+    advance(100);
+    EXPECT_THAT(m_fired.size(), Eq(4U));
+
+    EXPECT_TRUE(m_wheel.cancel(id));
+    EXPECT_TRUE(m_wheel.empty());
+}
+
+TEST_F(TimerWheelTests, NextExpiryIsLowerBoundOfNextFiring) {
+    EXPECT_THAT(m_wheel.nextExpiry(), Eq(std::numeric_limits<std::uint64_t>::max()));
+
+    m_wheel.add(5000, 0, 1);
+    for (auto next_tick{m_wheel.nextExpiry()}; m_fired.empty(); next_tick = m_wheel.nextExpiry()) {
+        ASSERT_THAT(next_tick, testing::Le(5000U));
+        advance(next_tick);
+    }
+}
+
+TEST_F(TimerWheelTests, TimersFireInOrderOfDueTicks) {
+    std::mt19937_64 random{42};
+    std::uniform_int_distribution<std::uint64_t> due_ticks{0, 64 * 64 * 64 * 4};
+    std::uniform_int_distribution<std::uint64_t> steps{1, 5000};
+    std::vector<std::uint64_t> due{};
+    for (int item{0}; item < 10000; ++item) {
+        due.push_back(due_ticks(random));
+        m_wheel.add(due.back(), 0, int{item});
+    }
+
+    std::uint64_t previous_now{0};
+    std::uint64_t now{0};
+    std::uint64_t last_due{0};
+    while (!m_wheel.empty()) {
+        now += steps(random);
+        m_wheel.advance(now, [&](int item) {
+            const auto due_tick{due[static_cast<std::size_t>(item)]};
+            EXPECT_THAT(due_tick, testing::Le(now));
+            EXPECT_TRUE(due_tick > previous_now || previous_now == 0);
+            EXPECT_THAT(due_tick, testing::Ge(last_due));
+            last_due = due_tick;
+            m_fired.push_back(item);
+        });
+        previous_now = now;
+    }
+    EXPECT_THAT(m_fired.size(), Eq(due.size()));
+}
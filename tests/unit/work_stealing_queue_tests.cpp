@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2023 RAIISoft GmbH
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pool_party/detail/work_stealing_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using testing::Eq;
+
+namespace {
+using TaskType = std::unique_ptr<int>;
+
+TaskType makeTask(int value) {
+    return TaskType{new int{value}};
+}
+}  // namespace
+
+class WorkStealingQueueTests : public testing::Test {
+protected:
+    static constexpr std::size_t m_worker_count{2};
+    pool_party::detail::WorkStealingQueue<TaskType> m_queue{m_worker_count};
+    TaskType m_task{};
+};
+
+TEST_F(WorkStealingQueueTests, PopFromEmptyQueueFails) {
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_FALSE(m_queue.tryPop(m_task, 0));
+    EXPECT_FALSE(m_queue.tryPop(m_task, pool_party::detail::no_worker_index));
+}
+
+TEST_F(WorkStealingQueueTests, WorkerPopsOwnTasksInLifoOrder) {
+    m_queue.push(makeTask(1), 0);
+    m_queue.push(makeTask(2), 0);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(*m_task, Eq(2));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(*m_task, Eq(1));
+}
+
+TEST_F(WorkStealingQueueTests, IdleWorkerStealsOldestTask) {
+    m_queue.push(makeTask(1), 0);
+    m_queue.push(makeTask(2), 0);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+    EXPECT_THAT(*m_task, Eq(1));
+}
+
+TEST_F(WorkStealingQueueTests, TasksFromOutsideThePoolAreInjected) {
+    m_queue.push(makeTask(1), pool_party::detail::no_worker_index);
+    EXPECT_FALSE(m_queue.empty());
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+    EXPECT_THAT(*m_task, Eq(1));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(WorkStealingQueueTests, PushRangeFromOutsideThePoolIsInjected) {
+    std::vector<TaskType> tasks{};
+    tasks.push_back(makeTask(1));
+    tasks.push_back(makeTask(2));
+    m_queue.push(tasks.begin(), tasks.end(), pool_party::detail::no_worker_index);
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 1));
+    EXPECT_THAT(*m_task, Eq(1));
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(*m_task, Eq(2));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(WorkStealingQueueTests, WorkerTakesShareOfInjectedTasks) {
+    const int task_count{9};
+    for (int i{0}; i < task_count; ++i) {
+        m_queue.push(makeTask(i), pool_party::detail::no_worker_index);
+    }
+
+    ASSERT_TRUE(m_queue.tryPop(m_task, 0));
+    EXPECT_THAT(*m_task, Eq(0));
+
+    // Half of the remaining tasks moved to the local queue of worker 0, the other worker steals them
+    int taken_tasks{1};
+    while (m_queue.tryPop(m_task, 1)) {
+        ++taken_tasks;
+    }
+    EXPECT_THAT(taken_tasks, Eq(task_count));
+}
+
+TEST_F(WorkStealingQueueTests, ReleaseRemainingTasksOnDestruction) {
+    auto shared_value{std::make_shared<int>(0)};
+    {
+        pool_party::detail::WorkStealingQueue<std::shared_ptr<int>> queue{1};
+        queue.push(std::shared_ptr<int>{shared_value}, 0);
+        EXPECT_THAT(shared_value.use_count(), Eq(2));
+    }
+    EXPECT_THAT(shared_value.use_count(), Eq(1));
+}
+
+TEST_F(WorkStealingQueueTests, QueueIsAlwaysUnbounded) {
+    EXPECT_THAT(pool_party::detail::queueCapacity(m_queue), Eq(std::numeric_limits<std::size_t>::max()));
+}